@@ -0,0 +1,108 @@
+#include "AddressTable.hpp"
+
+const unsigned int AddressTable::EMPTY;
+
+AddressTable::AddressTable() : _slots(INITIAL_SLOTS, EMPTY), _count(0) {}
+
+// Finaliseur de murmur3 : les préfixes CIDR ont leurs bits bas à zéro
+uint32_t AddressTable::hash(uint32_t address, unsigned char prefix) {
+    uint32_t h = address ^ ((uint32_t)prefix << 24);
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+size_t AddressTable::locate(uint32_t address, unsigned char prefix) const {
+    size_t mask = _slots.size() - 1;
+    size_t slot = hash(address, prefix) & mask;
+    while (_slots[slot] != EMPTY) {
+        const AddressEntry& entry = _entries[_slots[slot]];
+        if (entry.address == address && entry.prefix == prefix)
+            break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+// Doubler les cases et y replacer les index (les entrées ne bougent pas)
+void AddressTable::grow() {
+    std::vector<unsigned int> old;
+    old.swap(_slots);
+    _slots.assign(old.size() * 2, EMPTY);
+
+    for (size_t i = 0; i < old.size(); ++i) {
+        if (old[i] == EMPTY)
+            continue;
+        const AddressEntry& entry = _entries[old[i]];
+        _slots[locate(entry.address, entry.prefix)] = old[i];
+    }
+}
+
+AddressEntry* AddressTable::find(uint32_t address, unsigned char prefix) {
+    size_t slot = locate(address, prefix);
+    return _slots[slot] == EMPTY ? NULL : &_entries[_slots[slot]];
+}
+
+AddressEntry& AddressTable::insert(uint32_t address, unsigned char prefix) {
+    size_t slot = locate(address, prefix);
+    if (_slots[slot] != EMPTY)
+        return _entries[_slots[slot]];
+
+    // Charge maximale 3/4
+    if ((_count + 1) * 4 > _slots.size() * 3) {
+        grow();
+        slot = locate(address, prefix);
+    }
+
+    unsigned int index;
+    if (!_free.empty()) {
+        index = _free.back();
+        _free.pop_back();
+    } else {
+        index = _entries.size();
+        _entries.push_back(AddressEntry());
+    }
+
+    AddressEntry& entry = _entries[index];
+    entry.address = address;
+    entry.prefix = prefix;
+    entry.expiry.owner = &entry;
+    _slots[slot] = index;
+    ++_count;
+    return entry;
+}
+
+// Suppression par décalage arrière : aucune pierre tombale, les sondages restent courts
+void AddressTable::erase(AddressEntry* entry) {
+    size_t mask = _slots.size() - 1;
+    size_t hole = locate(entry->address, entry->prefix);
+    if (_slots[hole] == EMPTY)
+        return;
+    unsigned int index = _slots[hole];
+
+    for (size_t slot = (hole + 1) & mask; _slots[slot] != EMPTY; slot = (slot + 1) & mask) {
+        const AddressEntry& moved = _entries[_slots[slot]];
+        size_t home = hash(moved.address, moved.prefix) & mask;
+        // Déplaçable si le trou se trouve entre sa case d'origine et sa case actuelle
+        if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+            _slots[hole] = _slots[slot];
+            hole = slot;
+        }
+    }
+    _slots[hole] = EMPTY;
+
+    entry->expiry.cancel();
+    entry->connections = 0;
+    entry->current = 0;
+    entry->previous = 0;
+    entry->windowStart = 0;
+    _free.push_back(index);
+    --_count;
+}
+
+size_t AddressTable::size() const {
+    return _count;
+}
@@ -0,0 +1,52 @@
+#ifndef ADDRESSTABLE_HPP
+#define ADDRESSTABLE_HPP
+
+#include "TimerWheel.hpp"
+#include <deque>
+#include <vector>
+#include <stdint.h>
+
+// Compteurs d'admission d'une adresse IPv4 ou d'un préfixe CIDR
+struct AddressEntry {
+    uint32_t address;           // Ordre hôte, bits hors préfixe à zéro
+    unsigned char prefix;       // 32 pour une adresse seule
+    unsigned int connections;   // Connexions ouvertes
+    unsigned int current;       // Tentatives dans la fenêtre courante
+    unsigned int previous;      // Tentatives dans la fenêtre précédente
+    unsigned long windowStart;  // Début de la fenêtre courante (ms)
+    Timer expiry;               // Libération de l'entrée devenue inutile
+
+    AddressEntry() : address(0), prefix(0), connections(0), current(0), previous(0), windowStart(0) {}
+};
+
+// Table de hachage à adressage ouvert (sondage linéaire)
+// Les cases ne contiennent qu'un index 32 bits vers des entrées à adresse fixe
+// (deque + liste libre) : ni l'agrandissement ni la suppression par décalage
+// arrière ne déplacent une entrée dont le minuteur est armé.
+class AddressTable {
+private:
+    static const unsigned int EMPTY = 0xFFFFFFFFu;
+    static const size_t INITIAL_SLOTS = 64;
+
+    std::vector<unsigned int> _slots;   // Index dans _entries, EMPTY si libre
+    std::deque<AddressEntry> _entries;
+    std::vector<unsigned int> _free;    // Entrées recyclables
+    size_t _count;
+
+    AddressTable(const AddressTable&);
+    AddressTable& operator=(const AddressTable&);
+
+    static uint32_t hash(uint32_t address, unsigned char prefix);
+    size_t locate(uint32_t address, unsigned char prefix) const;   // Case de la clé ou case vide
+    void grow();
+
+public:
+    AddressTable();
+
+    AddressEntry* find(uint32_t address, unsigned char prefix);
+    AddressEntry& insert(uint32_t address, unsigned char prefix);  // Trouvée ou créée à zéro
+    void erase(AddressEntry* entry);
+    size_t size() const;
+};
+
+#endif
@@ -0,0 +1,145 @@
+#include "Admission.hpp"
+
+Admission::Admission(const ServerConfig& config, unsigned long nowMs)
+    : _expiry(1000, nowMs), _maxPerIp(config.maxPerIp), _maxPerCidr(config.maxPerCidr),
+      _cidrPrefix(config.cidrPrefix), _connectRate(config.connectRate),
+      _windowMs(config.connectWindow * 1000), _maxUnregistered(config.maxUnregistered),
+      _unregistered(0), _refused(0) {}
+
+bool Admission::hasCidrLimit() const {
+    return _maxPerCidr && _cidrPrefix > 0 && _cidrPrefix < 32;
+}
+
+// Démo et scripts de test : tous les clients viennent de 127.0.0.1
+static bool isLoopback(uint32_t address) {
+    return (address >> 24) == 127;
+}
+
+uint32_t Admission::network(uint32_t address) const {
+    return address & ~(0xFFFFFFFFu >> _cidrPrefix);
+}
+
+// Faire glisser la fenêtre : au-delà de deux fenêtres, plus rien ne compte
+void Admission::roll(AddressEntry& entry, unsigned long nowMs) const {
+    if (!_windowMs || nowMs - entry.windowStart < _windowMs)
+        return;
+    unsigned long windows = (nowMs - entry.windowStart) / _windowMs;
+    entry.previous = (windows == 1) ? entry.current : 0;
+    entry.current = 0;
+    entry.windowStart += windows * _windowMs;
+}
+
+// Compteur glissant : la fenêtre précédente pèse au prorata de son recouvrement
+unsigned long Admission::estimate(const AddressEntry& entry, unsigned long nowMs) const {
+    unsigned long elapsed = nowMs - entry.windowStart;
+    return (unsigned long)entry.previous * (_windowMs - elapsed) / _windowMs + entry.current;
+}
+
+// Une entrée sans connexion vit jusqu'à ce que ses tentatives sortent de la fenêtre
+void Admission::scheduleExpiry(AddressEntry& entry, unsigned long nowMs) {
+    unsigned long when = entry.windowStart + 2 * _windowMs;
+    _expiry.schedule(&entry.expiry, when > nowMs ? when : nowMs);
+}
+
+const char* Admission::admit(uint32_t address, unsigned long nowMs) {
+    if (_maxUnregistered && _unregistered >= _maxUnregistered) {
+        ++_refused;
+        return "Too many unregistered connections";
+    }
+    if (isLoopback(address)) {
+        ++_unregistered;
+        return NULL;
+    }
+
+    bool created = !_table.find(address, 32);
+    AddressEntry& host = _table.insert(address, 32);
+    if (created)
+        host.windowStart = nowMs;
+
+    // Chaque tentative compte, refusée ou non : un hôte qui insiste reste freiné
+    const char* refusal = NULL;
+    if (_connectRate && _windowMs) {
+        roll(host, nowMs);
+        if (estimate(host, nowMs) >= _connectRate)
+            refusal = "Reconnecting too fast, throttled";
+        ++host.current;
+    }
+    if (!refusal && _maxPerIp && host.connections >= _maxPerIp)
+        refusal = "Too many connections from your host";
+
+    AddressEntry* net = NULL;
+    if (!refusal && hasCidrLimit()) {
+        net = _table.find(network(address), _cidrPrefix);
+        if (net && net->connections >= _maxPerCidr)
+            refusal = "Too many connections from your network";
+    }
+
+    if (refusal) {
+        if (!host.connections)
+            scheduleExpiry(host, nowMs);
+        ++_refused;
+        return refusal;
+    }
+
+    if (hasCidrLimit() && !net) {
+        net = &_table.insert(network(address), _cidrPrefix);
+        net->windowStart = nowMs;
+    }
+    if (net) {
+        net->expiry.cancel();
+        ++net->connections;
+    }
+    host.expiry.cancel();
+    ++host.connections;
+    ++_unregistered;
+    return NULL;
+}
+
+void Admission::registered() {
+    if (_unregistered)
+        --_unregistered;
+}
+
+void Admission::releaseEntry(AddressEntry* entry, unsigned long nowMs) {
+    if (!entry || !entry->connections)
+        return;
+    if (--entry->connections == 0)
+        scheduleExpiry(*entry, nowMs);
+}
+
+void Admission::release(uint32_t address, bool wasRegistered, unsigned long nowMs) {
+    if (!wasRegistered)
+        registered();
+    if (isLoopback(address))
+        return;
+    releaseEntry(_table.find(address, 32), nowMs);
+    if (hasCidrLimit())
+        releaseEntry(_table.find(network(address), _cidrPrefix), nowMs);
+}
+
+void Admission::expire(unsigned long nowMs) {
+    _expiry.advance(nowMs);
+
+    Timer* timer;
+    while ((timer = _expiry.popExpired()) != NULL) {
+        AddressEntry* entry = static_cast<AddressEntry*>(timer->owner);
+        if (entry->connections)
+            continue;       // Réutilisée entre-temps : réarmée à sa prochaine libération
+        if (_windowMs && nowMs < entry->windowStart + 2 * _windowMs)
+            scheduleExpiry(*entry, nowMs);
+        else
+            _table.erase(entry);
+    }
+}
+
+size_t Admission::getUnregistered() const {
+    return _unregistered;
+}
+
+size_t Admission::getTrackedCount() const {
+    return _table.size();
+}
+
+unsigned long Admission::getRefusedCount() const {
+    return _refused;
+}
@@ -0,0 +1,54 @@
+#ifndef ADMISSION_HPP
+#define ADMISSION_HPP
+
+#include "AddressTable.hpp"
+#include "TimerWheel.hpp"
+#include "ServerConfig.hpp"
+#include <stdint.h>
+
+// Contrôle d'admission des connexions, par adresse source (IPv4, ordre hôte)
+// Décidé à l'acceptation, avant toute allocation de Client : connexions
+// ouvertes par IP et par préfixe CIDR, tentatives par IP sur une fenêtre
+// glissante, nombre global de clients non inscrits. Une entrée sans connexion
+// est libérée par minuteur dès que sa fenêtre ne compte plus.
+// La boucle locale (127.0.0.0/8) n'est soumise qu'au plafond des non inscrits.
+class Admission {
+private:
+    TimerWheel _expiry;
+    AddressTable _table;
+    size_t _maxPerIp;               // 0 = illimité
+    size_t _maxPerCidr;
+    unsigned int _cidrPrefix;       // 0 ou 32 = pas de limite par réseau
+    size_t _connectRate;            // Tentatives par fenêtre (0 = illimité)
+    unsigned long _windowMs;
+    size_t _maxUnregistered;
+    size_t _unregistered;
+    unsigned long _refused;         // Connexions refusées depuis le démarrage
+
+    Admission(const Admission&);
+    Admission& operator=(const Admission&);
+
+    bool hasCidrLimit() const;
+    uint32_t network(uint32_t address) const;
+    void roll(AddressEntry& entry, unsigned long nowMs) const;
+    unsigned long estimate(const AddressEntry& entry, unsigned long nowMs) const;
+    void scheduleExpiry(AddressEntry& entry, unsigned long nowMs);
+    void releaseEntry(AddressEntry* entry, unsigned long nowMs);
+
+public:
+    Admission(const ServerConfig& config, unsigned long nowMs);
+
+    // NULL si la connexion est admise (compteurs pris), sinon le motif du refus
+    const char* admit(uint32_t address, unsigned long nowMs);
+    void registered();      // Un client admis a terminé PASS/NICK/USER
+    void release(uint32_t address, bool wasRegistered, unsigned long nowMs);
+
+    // Libérer les entrées échues (appelé avec les minuteurs du serveur)
+    void expire(unsigned long nowMs);
+
+    size_t getUnregistered() const;
+    size_t getTrackedCount() const;     // Entrées IP et réseau en table
+    unsigned long getRefusedCount() const;
+};
+
+#endif
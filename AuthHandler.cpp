@@ -1,7 +1,13 @@
 #include "AuthHandler.hpp"
+#include "Server.hpp"
+#include "ClientManager.hpp"
+#include "ChannelManager.hpp"
+#include "CaseMapping.hpp"
+#include "Reply.hpp"
 #include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <cstring>
 
 // Forward declaration pour éviter l'include
 class Server;
@@ -36,46 +42,26 @@ bool AuthHandler::isValidNickname(const std::string& nick) const {
     return true;
 }
 
-// Convertir en minuscules pour comparaison insensible à la casse
-std::string AuthHandler::toLowerCase(const std::string& str) {
-    std::string result = str;
-    for (size_t i = 0; i < result.length(); ++i) {
-        if (result[i] >= 'A' && result[i] <= 'Z') {
-            result[i] = result[i] + ('a' - 'A');
-        }
-    }
-    return result;
-}
-
-// Comparer deux nicknames en ignorant la casse
-bool AuthHandler::compareNicknames(const std::string& nick1, const std::string& nick2) {
-    return toLowerCase(nick1) == toLowerCase(nick2);
-}
-
-// Vérifier si le nickname est déjà utilisé
-bool AuthHandler::isNicknameInUse(const std::string& nick) const {
-    for (std::map<int, Client*>::iterator it = _clients->begin(); it != _clients->end(); ++it) {
-        if (compareNicknames(it->second->getNickname(), nick))
-            return true;
-    }
-    return false;
+// Vérifier si le nickname est déjà utilisé (un client peut changer la casse du sien)
+bool AuthHandler::isNicknameInUse(const std::string& nick, const Client* self) const {
+    Client* holder = _server->getClientManager()->findByNick(nick);
+    return holder && holder != self;
 }
 
 // Envoyer message de bienvenue
 void AuthHandler::sendWelcome(Client* client) {
-    std::string serverName = "ft_irc.42.fr"; // À adapter
-    
-    sendNumericReply(client, RPL_WELCOME, 
-        "Welcome to the Internet Relay Network " + client->getPrefix());
-    
-    sendNumericReply(client, RPL_YOURHOST, 
-        "Your host is " + serverName + ", running version ft_irc-1.0");
-    
-    sendNumericReply(client, RPL_CREATED, 
-        "This server was created by 42 students");
-    
-    sendNumericReply(client, RPL_MYINFO, 
-        serverName + " ft_irc-1.0 o o");
+    const std::string& prefix = client->getPrefix();
+    
+    Reply::send(client, Reply::RPL_WELCOME, StringView(prefix.data() + 1, prefix.length() - 1));
+    Reply::send(client, Reply::RPL_YOURHOST, Reply::serverName(), Reply::version());
+    Reply::send(client, Reply::RPL_CREATED);
+    const char* userModes = Client::supportedModes();
+    Reply::send(client, Reply::RPL_MYINFO, Reply::serverName(), Reply::version(),
+                StringView(userModes, std::strlen(userModes)), Channel::supportedModes());
+    
+    // ISUPPORT : jetons en paramètres, hors du texte final
+    const char* mapping = CaseMapping::name();
+    Reply::send(client, Reply::RPL_ISUPPORT, StringView(mapping, std::strlen(mapping)));
 }
 
 // Envoyer erreur
@@ -83,36 +69,14 @@ void AuthHandler::sendError(Client* client, const std::string& error) {
     client->sendMessage("ERROR :" + error);
 }
 
-// Envoyer réponse numérique IRC
-void AuthHandler::sendNumericReply(Client* client, int code, const std::string& message) {
-    std::ostringstream oss;
-    oss << ":ft_irc.42.fr ";
-    if (code < 100) oss << "0";
-    if (code < 10) oss << "0";
-    oss << code << " ";
-    
-    if (!client->getNickname().empty())
-        oss << client->getNickname();
-    else
-        oss << "*";
-    
-    oss << " :" << message;
-    client->sendMessage(oss.str());
-}
-
 // Commande PASS
-bool AuthHandler::handlePass(Client* client, const std::vector<std::string>& params) {
+bool AuthHandler::handlePass(Client* client, const MessageParams& params) {
     if (client->isRegistered()) {
-        sendNumericReply(client, ERR_ALREADYREGISTERED, "You may not reregister");
+        Reply::send(client, Reply::ERR_ALREADYREGISTERED);
         return false;
     }
     
-    if (params.empty()) {
-        sendNumericReply(client, ERR_NEEDMOREPARAMS, "PASS :Not enough parameters");
-        return false;
-    }
-    
-    std::string password = params[0];
+    std::string password = params[0].str();
     // Enlever le ':' au début si présent
     if (!password.empty() && password[0] == ':')
         password = password.substr(1);
@@ -123,43 +87,41 @@ bool AuthHandler::handlePass(Client* client, const std::vector<std::string>& par
             client->setState(PASS_OK);
         return true;
     } else {
-        sendNumericReply(client, ERR_PASSWDMISMATCH, "Password incorrect");
+        Reply::send(client, Reply::ERR_PASSWDMISMATCH);
         return false;
     }
 }
 
 // Commande NICK
-bool AuthHandler::handleNick(Client* client, const std::vector<std::string>& params) {
+bool AuthHandler::handleNick(Client* client, const MessageParams& params) {
     if (params.empty()) {
-        sendNumericReply(client, ERR_NONICKNAMEGIVEN, "No nickname given");
+        Reply::send(client, Reply::ERR_NONICKNAMEGIVEN);
         return false;
     }
     
-    std::string newNick = params[0];
+    std::string newNick = params[0].str();
     
     // Validation du nickname
     if (!isValidNickname(newNick)) {    
-        sendNumericReply(client, ERR_ERRONEOUSNICKNAME, newNick + " :Erroneous nickname");
+        Reply::send(client, Reply::ERR_ERRONEUSNICKNAME, newNick);
             return false;
     }
     
     // Vérifier si le nick est déjà utilisé
-    if (isNicknameInUse(newNick)) {
-        sendNumericReply(client, ERR_NICKNAMEINUSE, newNick + " :Nickname is already in use");
+    if (isNicknameInUse(newNick, client)) {
+        Reply::send(client, Reply::ERR_NICKNAMEINUSE, newNick);
         return false;
     }
     
     // Si le client a déjà un nickname, notifier le changement
     if (!client->getNickname().empty() && client->isRegistered()) {
         std::string oldNick = client->getNickname();
-        client->setNickname(newNick);
+        _server->getClientManager()->setNickname(client, newNick);
         
-        // Notifier tous les canaux du changement de nick
-        // (sera géré par le serveur principal lors du traitement)
-        std::string nickMsg = ":" + oldNick + "!" + client->getUsername() + "@" + client->getHostname() + " NICK :" + newNick;
-        client->sendMessage(nickMsg);
+        // Notifier le client et ses canaux du changement de nick
+        _server->getChannelManager()->broadcastNickChange(client, oldNick, newNick);
     } else {
-        client->setNickname(newNick);
+        _server->getClientManager()->setNickname(client, newNick);
         
         // Mettre à jour l'état
         if (client->getState() == CONNECTING && client->isPasswordOk())
@@ -173,21 +135,16 @@ bool AuthHandler::handleNick(Client* client, const std::vector<std::string>& par
 }
 
 // Commande USER
-bool AuthHandler::handleUser(Client* client, const std::vector<std::string>& params) {
+bool AuthHandler::handleUser(Client* client, const MessageParams& params) {
     if (client->isRegistered()) {
-        sendNumericReply(client, ERR_ALREADYREGISTERED, "You may not reregister");
-        return false;
-    }
-    
-    if (params.size() < 4) {
-        sendNumericReply(client, ERR_NEEDMOREPARAMS, "USER :Not enough parameters");
+        Reply::send(client, Reply::ERR_ALREADYREGISTERED);
         return false;
     }
     
-    std::string username = params[0];
-    std::string hostname = params[1]; // Généralement ignoré
-    std::string servername = params[2]; // Généralement ignoré
-    std::string realname = params[3];
+    std::string username = params[0].str();
+    std::string hostname = params[1].str(); // Généralement ignoré
+    std::string servername = params[2].str(); // Généralement ignoré
+    std::string realname = params[3].str();
     
     // Enlever le ':' au début du realname si présent
     if (!realname.empty() && realname[0] == ':')
@@ -206,6 +163,24 @@ bool AuthHandler::handleUser(Client* client, const std::vector<std::string>& par
     return true;
 }
 
+// Commande OPER
+bool AuthHandler::handleOper(Client* client, const MessageParams& params) {
+    const ServerConfig& config = _server->getConfig();
+    if (config.operPassword.empty() || params[0] != config.operName) {
+        Reply::send(client, Reply::ERR_NOOPERHOST);
+        return false;
+    }
+    
+    if (params[1] != config.operPassword) {
+        Reply::send(client, Reply::ERR_PASSWDMISMATCH);
+        return false;
+    }
+    
+    client->setIrcOperator(true);
+    Reply::send(client, Reply::RPL_YOUREOPER);
+    return true;
+}
+
 // Vérifier si le client peut être enregistré
 void AuthHandler::checkRegistration(Client* client) {
     if (!client->isPasswordOk()) {
@@ -219,6 +194,8 @@ void AuthHandler::checkRegistration(Client* client) {
     if (!client->isRegistered()) {
         client->setState(REGISTERED);
         client->updateLastActivity();
+        if (_server)
+            _server->getClientManager()->clientRegistered();
         sendWelcome(client);
     }
 }
@@ -227,9 +204,3 @@ void AuthHandler::checkRegistration(Client* client) {
 bool AuthHandler::isClientRegistered(Client* client) const {
     return client->isRegistered();
 }
-
-// Gérer timeout
-void AuthHandler::handleTimeout(Client* client) {
-    sendError(client, "Ping timeout");
-    // Le serveur devra fermer la connexion
-}
\ No newline at end of file
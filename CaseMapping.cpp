@@ -0,0 +1,101 @@
+#include "CaseMapping.hpp"
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+unsigned char CaseMapping::_table[256];
+CaseMapping::Mapping CaseMapping::_mapping = CaseMapping::RFC1459;
+
+// Table remplie avant main (utilisée dès la première connexion)
+namespace {
+    struct CaseMappingInit {
+        CaseMappingInit() { CaseMapping::initialize(); }
+    };
+    CaseMappingInit caseMappingInit;
+}
+
+void CaseMapping::initialize() {
+    build(RFC1459);
+}
+
+void CaseMapping::build(Mapping mapping) {
+    _mapping = mapping;
+    for (int c = 0; c < 256; ++c)
+        _table[c] = static_cast<unsigned char>(c);
+
+    // A-Z et, hors ascii, [\] : plage contiguë 0x41-0x5D décalée de 0x20
+    int rangeEnd = (mapping == ASCII) ? 'Z' : ']';
+    for (int c = 'A'; c <= rangeEnd; ++c)
+        _table[c] = static_cast<unsigned char>(c + ('a' - 'A'));
+    if (mapping == RFC1459)
+        _table[static_cast<unsigned char>('~')] = '^';
+}
+
+bool CaseMapping::select(const std::string& name) {
+    if (name == "rfc1459")
+        build(RFC1459);
+    else if (name == "strict-rfc1459")
+        build(STRICT_RFC1459);
+    else if (name == "ascii")
+        build(ASCII);
+    else
+        return false;
+    return true;
+}
+
+const char* CaseMapping::name() {
+    switch (_mapping) {
+        case ASCII:             return "ascii";
+        case STRICT_RFC1459:    return "strict-rfc1459";
+        default:                return "rfc1459";
+    }
+}
+
+void CaseMapping::foldInPlace(char* data, size_t length) {
+    size_t i = 0;
+#ifdef __SSE2__
+    // Octets dans [A, fin de plage] : +0x20 ; '~' : -0x20 (rfc1459)
+    // Comparaisons signées : les octets >= 0x80 sont négatifs, donc hors plage
+    const __m128i lower = _mm_set1_epi8('A' - 1);
+    const __m128i upper = _mm_set1_epi8(_mapping == ASCII ? 'Z' + 1 : ']' + 1);
+    const __m128i tilde = _mm_set1_epi8('~');
+    const __m128i delta = _mm_set1_epi8('a' - 'A');
+    const __m128i foldTilde = _mm_set1_epi8(_mapping == RFC1459 ? -1 : 0);
+
+    for (; i + 16 <= length; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i inRange = _mm_and_si128(_mm_cmpgt_epi8(bytes, lower), _mm_cmplt_epi8(bytes, upper));
+        __m128i isTilde = _mm_and_si128(_mm_cmpeq_epi8(bytes, tilde), foldTilde);
+        bytes = _mm_add_epi8(bytes, _mm_and_si128(inRange, delta));
+        bytes = _mm_sub_epi8(bytes, _mm_and_si128(isTilde, delta));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), bytes);
+    }
+#endif
+    for (; i < length; ++i)
+        data[i] = static_cast<char>(_table[static_cast<unsigned char>(data[i])]);
+}
+
+void CaseMapping::fold(const StringView& in, std::string& out) {
+    out.assign(in.data, in.length);
+    if (!out.empty())
+        foldInPlace(&out[0], out.length());
+}
+
+bool CaseMapping::equals(const StringView& a, const StringView& b) {
+    if (a.length != b.length)
+        return false;
+    for (size_t i = 0; i < a.length; ++i) {
+        if (_table[static_cast<unsigned char>(a.data[i])] != _table[static_cast<unsigned char>(b.data[i])])
+            return false;
+    }
+    return true;
+}
+
+size_t CaseMapping::hash(const StringView& name) {
+    size_t hash = 2166136261u;
+    for (size_t i = 0; i < name.length; ++i) {
+        hash ^= _table[static_cast<unsigned char>(name.data[i])];
+        hash *= 16777619u;
+    }
+    return hash;
+}
@@ -0,0 +1,39 @@
+#ifndef CASEMAPPING_HPP
+#define CASEMAPPING_HPP
+
+#include "StringView.hpp"
+#include <string>
+#include <cstddef>
+
+// Repli de casse IRC via une table de 256 octets, sans allocation
+//   ascii          : A-Z -> a-z
+//   strict-rfc1459 : ascii + []\ -> {}|
+//   rfc1459        : strict-rfc1459 + ~ -> ^
+// Choisi une fois au démarrage (FTIRC_CASEMAPPING) et annoncé dans ISUPPORT.
+class CaseMapping {
+public:
+    enum Mapping {
+        ASCII,
+        STRICT_RFC1459,
+        RFC1459
+    };
+
+private:
+    static unsigned char _table[256];
+    static Mapping _mapping;
+
+    static void build(Mapping mapping);
+
+public:
+    static void initialize();
+    static bool select(const std::string& name);    // false si inconnu
+    static const char* name();
+
+    static unsigned char fold(unsigned char c) { return _table[c]; }
+    static void foldInPlace(char* data, size_t length);     // Chemin SSE2 par blocs de 16
+    static void fold(const StringView& in, std::string& out);
+    static bool equals(const StringView& a, const StringView& b);
+    static size_t hash(const StringView& name);     // FNV-1a sur les octets repliés
+};
+
+#endif
@@ -1,68 +1,140 @@
 #include "Channel.hpp"
+#include "NameIndex.hpp"
+#include "Reply.hpp"
+#include "Clock.hpp"
 #include <algorithm>
 #include <sstream>
 
 Channel::Channel(const std::string& name) 
-    : _name(name), _userLimit(0), _creationTime(time(NULL)) {
-    // Le créateur devient automatiquement opérateur
-}
+    : _name(name), _nameHash(NameIndex<Channel*>::hash(name)), _registrySlot(0),
+      _modes(0), _userLimit(0), _creationTime(Clock::wallTime()),
+      _namesBodyLimit(510 - Reply::headerLength(Reply::RPL_NAMREPLY, 9, name.length())),
+      _namesValid(true) {}
 
 Channel::~Channel() {}
 
 // Getters
 const std::string& Channel::getName() const { return _name; }
+size_t Channel::getNameHash() const { return _nameHash; }
+size_t Channel::getRegistrySlot() const { return _registrySlot; }
 const std::string& Channel::getTopic() const { return _topic; }
 const std::string& Channel::getKey() const { return _key; }
 size_t Channel::getUserLimit() const { return _userLimit; }
 size_t Channel::getMemberCount() const { return _members.size(); }
 
+void Channel::setRegistrySlot(size_t slot) {
+    _registrySlot = slot;
+}
+
+unsigned int Channel::modeBit(char mode) {
+    switch (mode) {
+        case 'i': return MODE_INVITE;
+        case 'k': return MODE_KEY;
+        case 'l': return MODE_LIMIT;
+        case 't': return MODE_TOPIC;
+        default:  return 0;
+    }
+}
+
+unsigned int Channel::memberFlag(char mode) {
+    return mode == 'o' ? MEMBER_OP : 0;
+}
+
+// Déduits de modeBit et memberFlag : 004 suit les modes réellement gérés
+const std::string& Channel::supportedModes() {
+    static std::string modes;
+    if (modes.empty()) {
+        for (char c = 'a'; c <= 'z'; ++c)
+            if (modeBit(c))
+                modes += c;
+        for (char c = 'a'; c <= 'z'; ++c)
+            if (memberFlag(c))
+                modes += c;
+    }
+    return modes;
+}
+
 bool Channel::hasMode(char mode) const {
-    return _modes.find(mode) != _modes.end();
+    return (_modes & modeBit(mode)) != 0;
 }
 
 // Membres
+// Recherche via les liens du client : O(canaux du client), pas O(membres)
+int Channel::findMember(Client* client) const {
+    return client ? client->findChannelLink(this) : -1;
+}
+
+void Channel::setMemberClientSlot(unsigned int memberSlot, unsigned int clientSlot) {
+    _members[memberSlot].clientSlot = clientSlot;
+}
+
 bool Channel::addMember(Client* client) {
     if (!client) return false;
     
-    if (_members.find(client) != _members.end())
+    if (findMember(client) != -1)
         return false; // Déjà membre
     
-    _members.insert(client);
+    Member member;
+    member.client = client;
+    member.flags = 0;
+    member.clientSlot = client->addChannelLink(this, _members.size());
+    _members.push_back(member);
+    removeInvite(client);
+    if (_namesValid)
+        appendName(member);
     return true;
 }
 
+// Retrait par échange avec le dernier membre, index croisés mis à jour
 void Channel::removeMember(Client* client) {
-    if (!client) return;
+    int slot = findMember(client);
+    if (slot == -1) {
+        removeInvite(client);
+        return;
+    }
     
-    _members.erase(client);
-    _operators.erase(client);
-    _inviteList.erase(client);
+    unsigned int clientSlot = _members[slot].clientSlot;
+    const Member& last = _members.back();
+    if (static_cast<size_t>(slot) != _members.size() - 1) {
+        _members[slot] = last;
+        _members[slot].client->setChannelLinkSlot(_members[slot].clientSlot, slot);
+    }
+    _members.pop_back();
+    client->removeChannelLink(clientSlot);
+    invalidateNames();
 }
 
 bool Channel::isMember(Client* client) const {
-    return _members.find(client) != _members.end();
+    return findMember(client) != -1;
 }
 
 bool Channel::isOperator(Client* client) const {
-    return _operators.find(client) != _operators.end();
+    int slot = findMember(client);
+    return slot != -1 && (_members[slot].flags & MEMBER_OP);
 }
 
 void Channel::addOperator(Client* client) {
-    if (client && isMember(client)) {
-        _operators.insert(client);
+    int slot = findMember(client);
+    if (slot != -1 && !(_members[slot].flags & MEMBER_OP)) {
+        _members[slot].flags |= MEMBER_OP;
+        invalidateNames();
     }
 }
 
 void Channel::removeOperator(Client* client) {
-    _operators.erase(client);
+    int slot = findMember(client);
+    if (slot != -1 && (_members[slot].flags & MEMBER_OP)) {
+        _members[slot].flags &= ~MEMBER_OP;
+        invalidateNames();
+    }
 }
 
 // Modes
 void Channel::setMode(char mode, bool set) {
     if (set) {
-        _modes.insert(mode);
+        _modes |= modeBit(mode);
     } else {
-        _modes.erase(mode);
+        _modes &= ~modeBit(mode);
     }
 }
 
@@ -90,31 +162,55 @@ void Channel::setTopic(const std::string& topic) {
 
 // Invitations
 void Channel::addInvite(Client* client) {
-    if (client) {
-        _inviteList.insert(client);
+    if (client && !isInvited(client)) {
+        _inviteList.push_back(client);
     }
 }
 
 void Channel::removeInvite(Client* client) {
-    _inviteList.erase(client);
+    for (size_t i = 0; i < _inviteList.size(); ++i) {
+        if (_inviteList[i] == client) {
+            _inviteList[i] = _inviteList.back();
+            _inviteList.pop_back();
+            return;
+        }
+    }
 }
 
 bool Channel::isInvited(Client* client) const {
-    return _inviteList.find(client) != _inviteList.end();
+    for (size_t i = 0; i < _inviteList.size(); ++i) {
+        if (_inviteList[i] == client)
+            return true;
+    }
+    return false;
 }
 
-// Broadcast
+// Broadcast : ligne sérialisée une seule fois, partagée par tous les membres
 void Channel::broadcast(const std::string& message, Client* sender) {
-    for (std::set<Client*>::iterator it = _members.begin(); it != _members.end(); ++it) {
-        if (*it != sender) { // Ne pas renvoyer à l'expéditeur
-            (*it)->sendMessage(message);
+    broadcast(WireBuffer(message), sender);
+}
+
+void Channel::broadcast(const WireBuffer& buffer, Client* sender) {
+    for (size_t i = 0; i < _members.size(); ++i) {
+        if (_members[i].client != sender) { // Ne pas renvoyer à l'expéditeur
+            _members[i].client->sendBuffer(buffer);
         }
     }
 }
 
 void Channel::broadcastToOperators(const std::string& message) {
-    for (std::set<Client*>::iterator it = _operators.begin(); it != _operators.end(); ++it) {
-        (*it)->sendMessage(message);
+    WireBuffer buffer(message);
+    for (size_t i = 0; i < _members.size(); ++i) {
+        if (_members[i].flags & MEMBER_OP)
+            _members[i].client->sendBuffer(buffer);
+    }
+}
+
+// Ajouter les membres pas encore visités pour cette diffusion (dédoublonnage)
+void Channel::collectRecipients(std::vector<Client*>& out, unsigned long epoch) const {
+    for (size_t i = 0; i < _members.size(); ++i) {
+        if (_members[i].client->markFanout(epoch))
+            out.push_back(_members[i].client);
     }
 }
 
@@ -157,10 +253,12 @@ bool Channel::canChangeTopic(Client* client) const {
 
 // Utilitaires
 std::string Channel::getModeString() const {
+    static const char letters[] = "iklt";
     std::string modes = "+";
     
-    for (std::set<char>::const_iterator it = _modes.begin(); it != _modes.end(); ++it) {
-        modes += *it;
+    for (size_t i = 0; letters[i]; ++i) {
+        if (hasMode(letters[i]))
+            modes += letters[i];
     }
     
     if (modes == "+") {
@@ -170,19 +268,51 @@ std::string Channel::getModeString() const {
     return modes;
 }
 
-std::string Channel::getMembersList() const {
-    std::string list;
+// Ajouter un nom au dernier morceau, ou ouvrir un nouveau morceau s'il déborde
+// Seul le morceau modifié est resérialisé
+void Channel::appendName(const Member& member) {
+    std::string name;
+    if (member.flags & MEMBER_OP)
+        name = "@";
+    else if (member.flags & MEMBER_VOICE)
+        name = "+";
+    name += member.client->getNickname();
     
-    for (std::set<Client*>::const_iterator it = _members.begin(); it != _members.end(); ++it) {
-        if (!list.empty()) list += " ";
-        
-        if (isOperator(*it)) {
-            list += "@";
-        }
-        list += (*it)->getNickname();
+    if (_namesText.empty() || _namesText.back().length() + 1 + name.length() > _namesBodyLimit) {
+        _namesText.push_back(name);
+        _namesChunks.push_back(WireBuffer(name));
+        return;
     }
+    _namesText.back() += " ";
+    _namesText.back() += name;
+    _namesChunks.back() = WireBuffer(_namesText.back());
+}
+
+void Channel::rebuildNames() {
+    _namesText.clear();
+    _namesChunks.clear();
+    for (size_t i = 0; i < _members.size(); ++i)
+        appendName(_members[i]);
+    _namesValid = true;
+}
+
+void Channel::invalidateNames() {
+    _namesValid = false;
+}
+
+// 353 : en-tête propre au destinataire + corps partagés, puis 366
+void Channel::sendNames(Client* client) {
+    if (!client) return;
+    
+    if (!_namesValid)
+        rebuildNames();
+    
+    // Corps dimensionnés pour l'en-tête le plus long (NICKLEN = 9)
+    WireBuffer header = Reply::header(client, Reply::RPL_NAMREPLY, _name);
+    for (size_t i = 0; i < _namesChunks.size(); ++i)
+        client->sendBuffer(header, _namesChunks[i]);
     
-    return list;
+    Reply::send(client, Reply::RPL_ENDOFNAMES, _name);
 }
 
 std::string Channel::getChannelInfo() const {
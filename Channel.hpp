@@ -2,21 +2,56 @@
 #define CHANNEL_HPP
 
 #include "Client.hpp"
+#include "WireBuffer.hpp"
 #include <string>
-#include <set>
-#include <map>
+#include <vector>
 
 class Channel {
+public:
+    // Drapeaux par membre
+    enum MemberFlag {
+        MEMBER_OP       = 1 << 0,
+        MEMBER_VOICE    = 1 << 1
+    };
+    
+    // Modes du canal (masque de bits)
+    enum ModeBit {
+        MODE_INVITE     = 1 << 0,   // +i
+        MODE_KEY        = 1 << 1,   // +k
+        MODE_LIMIT      = 1 << 2,   // +l
+        MODE_TOPIC      = 1 << 3    // +t
+    };
+
 private:
+    // Appartenance : 16 octets, tableau contigu parcouru linéairement
+    // clientSlot = position du lien dans Client::_channels (retrait en O(1))
+    struct Member {
+        Client *client;
+        unsigned int flags;
+        unsigned int clientSlot;
+    };
+    
+
     std::string _name;
+    size_t _nameHash;           // Hachage précalculé du nom replié (clé du registre)
+    size_t _registrySlot;       // Position dans la liste du ChannelManager
     std::string _topic;
     std::string _key;           // Mode +k
-    std::set<Client*> _members;
-    std::set<Client*> _operators;
-    std::set<char> _modes;      // i, t, k, o, l
+    std::vector<Member> _members;
+    unsigned int _modes;        // ModeBit
     size_t _userLimit;          // Mode +l
-    std::set<Client*> _inviteList; // Mode +i
+    std::vector<Client*> _inviteList; // Mode +i : non-membres, consommé au JOIN
     time_t _creationTime;
+    
+    // Cache NAMES : corps des lignes 353 découpés sous 512 octets et sérialisés une fois
+    // Complété au JOIN, invalidé au départ, changement d'op ou de pseudo
+    std::vector<std::string> _namesText;
+    std::vector<WireBuffer> _namesChunks;
+    size_t _namesBodyLimit;
+    bool _namesValid;
+    
+    void appendName(const Member& member);
+    void rebuildNames();
 
 public:
     Channel(const std::string& name);
@@ -24,6 +59,12 @@ public:
     
     // Getters
     const std::string& getName() const;
+    size_t getNameHash() const;
+    size_t getRegistrySlot() const;
+    void setRegistrySlot(size_t slot);
+    static unsigned int modeBit(char mode);
+    static unsigned int memberFlag(char mode);
+    static const std::string& supportedModes();     // Modes de canal puis de membre (004)
     const std::string& getTopic() const;
     const std::string& getKey() const;
     size_t getUserLimit() const;
@@ -31,6 +72,8 @@ public:
     bool hasMode(char mode) const;
     
     // Membres
+    int findMember(Client* client) const;   // Index dans _members, -1 si absent
+    void setMemberClientSlot(unsigned int memberSlot, unsigned int clientSlot);
     bool addMember(Client* client);
     void removeMember(Client* client);
     bool isMember(Client* client) const;
@@ -51,7 +94,9 @@ public:
     
     // Broadcast
     void broadcast(const std::string& message, Client* sender = NULL);
+    void broadcast(const WireBuffer& buffer, Client* sender = NULL);
     void broadcastToOperators(const std::string& message);
+    void collectRecipients(std::vector<Client*>& out, unsigned long epoch) const;
     
     // Validation
     bool canJoin(Client* client, const std::string& key = "") const;
@@ -60,7 +105,8 @@ public:
     
     // Utilitaires
     std::string getModeString() const;
-    std::string getMembersList() const;
+    void sendNames(Client* client);
+    void invalidateNames();
     std::string getChannelInfo() const;
 };
 
@@ -1,16 +1,17 @@
 #include "ChannelManager.hpp"
 #include "Server.hpp"
 #include "AuthHandler.hpp"
+#include "Reply.hpp"
 #include <algorithm>
 #include <cstdlib>
 #include <sstream>
 
-ChannelManager::ChannelManager(Server *server) : _server(server) {}
+ChannelManager::ChannelManager(Server *server) : _server(server), _fanoutEpoch(0) {}
 
 ChannelManager::~ChannelManager() {
     // Nettoyer tous les canaux
-    for (std::map<std::string, Channel*>::iterator it = _channels.begin(); it != _channels.end(); ++it) {
-        delete it->second;
+    for (size_t i = 0; i < _channels.size(); ++i) {
+        delete _channels[i];
     }
     _channels.clear();
 }
@@ -26,7 +27,7 @@ bool ChannelManager::isValidChannelName(const std::string& name) const {
     
     // Pas d'espaces, virgules, ou caractères de contrôle
     for (size_t i = 1; i < name.length(); i++) {
-        char c = name[i];
+        unsigned char c = name[i];
         if (c <= 32 || c == ',' || c == '\x07') // espace, virgule, bell
             return false;
     }
@@ -35,15 +36,19 @@ bool ChannelManager::isValidChannelName(const std::string& name) const {
 }
 
 // Gestion des canaux
+// Le nom est validé par l'appelant (joinChannel), une seule fois
 Channel* ChannelManager::createChannel(const std::string& name, Client* creator) {
-    if (!isValidChannelName(name) || !creator)
+    if (!creator)
         return NULL;
     
-    if (channelExists(name))
-        return getChannel(name);
+    Channel* existing = getChannel(name);
+    if (existing)
+        return existing;
     
     Channel* channel = new Channel(name);
-    _channels[name] = channel;
+    _channelIndex.insert(name, channel);
+    channel->setRegistrySlot(_channels.size());
+    _channels.push_back(channel);
     
     // Le créateur devient membre et opérateur
     channel->addMember(creator);
@@ -52,28 +57,44 @@ Channel* ChannelManager::createChannel(const std::string& name, Client* creator)
     return channel;
 }
 
-Channel* ChannelManager::getChannel(const std::string& name) {
-    std::map<std::string, Channel*>::iterator it = _channels.find(name);
-    return (it != _channels.end()) ? it->second : NULL;
+// Résolution O(1) sans allocation, insensible à la casse IRC
+Channel* ChannelManager::getChannel(const StringView& name) const {
+    return _channelIndex.find(name);
 }
 
-void ChannelManager::removeChannel(const std::string& name) {
-    std::map<std::string, Channel*>::iterator it = _channels.find(name);
-    if (it != _channels.end()) {
-        delete it->second;
-        _channels.erase(it);
-    }
+void ChannelManager::removeChannel(Channel* channel) {
+    if (!channel)
+        return;
+    
+    _channelIndex.erase(channel->getName(), channel->getNameHash());
+    
+    // Retrait par échange avec le dernier
+    size_t slot = channel->getRegistrySlot();
+    _channels[slot] = _channels.back();
+    _channels[slot]->setRegistrySlot(slot);
+    _channels.pop_back();
+    
+    delete channel;
 }
 
-bool ChannelManager::channelExists(const std::string& name) const {
-    return _channels.find(name) != _channels.end();
+bool ChannelManager::channelExists(const StringView& name) const {
+    return getChannel(name) != NULL;
 }
 
 // Commandes IRC
 bool ChannelManager::joinChannel(Client* client, const std::string& channelName, const std::string& key) {
-    if (!client || !isValidChannelName(channelName))
+    if (!client)
         return false;
     
+    // Nom refusé avant toute création : sans préfixe de canal 403, sinon 476
+    if (!isValidChannelName(channelName)) {
+        if (channelName.empty() || (channelName[0] != '#' && channelName[0] != '&'))
+            Reply::send(client, Reply::ERR_NOSUCHCHANNEL, channelName);
+        else
+            Reply::send(client, Reply::ERR_BADCHANMASK, channelName);
+        return false;
+    }
+    
     Channel* channel = getChannel(channelName);
     
     // Créer le canal s'il n'existe pas
@@ -82,22 +103,16 @@ bool ChannelManager::joinChannel(Client* client, const std::string& channelName,
         if (!channel) return false;
         
         // Envoyer confirmation de JOIN
-        std::string joinMsg = client->getPrefix() + " JOIN :" + channelName;
+        std::string joinMsg = client->getPrefix() + " JOIN :" + channel->getName();
         client->sendMessage(joinMsg);
         
         // Envoyer topic si défini
         if (!channel->getTopic().empty()) {
-            std::string topicMsg = ":ft_irc.42.fr 332 " + client->getNickname() + " " + channelName + " :" + channel->getTopic();
-            client->sendMessage(topicMsg);
+            Reply::send(client, Reply::RPL_TOPIC, channel->getName(), channel->getTopic());
         }
         
         // Envoyer liste des utilisateurs (NAMES)
-        std::string namesList = channel->getMembersList();
-        std::string namesMsg = ":ft_irc.42.fr 353 " + client->getNickname() + " = " + channelName + " :" + namesList;
-        client->sendMessage(namesMsg);
-        
-        std::string endNamesMsg = ":ft_irc.42.fr 366 " + client->getNickname() + " " + channelName + " :End of NAMES list";
-        client->sendMessage(endNamesMsg);
+        channel->sendNames(client);
         
         return true;
     }
@@ -111,28 +126,22 @@ bool ChannelManager::joinChannel(Client* client, const std::string& channelName,
         return false;
     
     // Notifier tous les membres du JOIN
-    std::string joinMsg = client->getPrefix() + " JOIN :" + channelName;
+    std::string joinMsg = client->getPrefix() + " JOIN :" + channel->getName();
     channel->broadcast(joinMsg, NULL); // Envoyer à tous y compris le client qui rejoint
     
     // Envoyer topic si défini
     if (!channel->getTopic().empty()) {
-        std::string topicMsg = ":ft_irc.42.fr 332 " + client->getNickname() + " " + channelName + " :" + channel->getTopic();
-        client->sendMessage(topicMsg);
+        Reply::send(client, Reply::RPL_TOPIC, channel->getName(), channel->getTopic());
     }
     
     // Envoyer liste des utilisateurs (NAMES)
-    std::string namesList = channel->getMembersList();
-    std::string namesMsg = ":ft_irc.42.fr 353 " + client->getNickname() + " = " + channelName + " :" + namesList;
-    client->sendMessage(namesMsg);
-    
-    std::string endNamesMsg = ":ft_irc.42.fr 366 " + client->getNickname() + " " + channelName + " :End of NAMES list";
-    client->sendMessage(endNamesMsg);
+    channel->sendNames(client);
     
     return true;
 }
 
 bool ChannelManager::partChannel(Client* client, const std::string& channelName, const std::string& reason) {
-    if (!client || !isValidChannelName(channelName))
+    if (!client)
         return false;
     
     Channel* channel = getChannel(channelName);
@@ -140,7 +149,7 @@ bool ChannelManager::partChannel(Client* client, const std::string& channelName,
         return false;
     
     // Notifier le PART
-    std::string partMsg = client->getPrefix() + " PART " + channelName;
+    std::string partMsg = client->getPrefix() + " PART " + channel->getName();
     if (!reason.empty()) {
         partMsg += " :" + reason;
     }
@@ -153,18 +162,21 @@ bool ChannelManager::partChannel(Client* client, const std::string& channelName,
     
     // Supprimer le canal s'il est vide
     if (channel->getMemberCount() == 0) {
-        removeChannel(channelName);
+        removeChannel(channel);
     }
     
     return true;
 }
 
 bool ChannelManager::sendToChannel(const std::string& channelName, const std::string& message, Client* sender) {
-    if (!sender || !isValidChannelName(channelName))
+    if (!sender)
         return false;
     
-    Channel* channel = getChannel(channelName);
-    if (!channel || !channel->canSpeak(sender))
+    return sendToChannel(getChannel(channelName), message, sender);
+}
+
+bool ChannelManager::sendToChannel(Channel* channel, const std::string& message, Client* sender) {
+    if (!sender || !channel || !channel->canSpeak(sender))
         return false;
     
     channel->broadcast(message, sender);
@@ -173,7 +185,7 @@ bool ChannelManager::sendToChannel(const std::string& channelName, const std::st
 
 // Méthodes de base (stubs pour compilation)
 bool ChannelManager::kickFromChannel(Client* kicker, const std::string& channelName, const std::string& targetNick, const std::string& reason) {
-    if (!kicker || !isValidChannelName(channelName))
+    if (!kicker)
         return false;
     
     Channel* channel = getChannel(channelName);
@@ -185,20 +197,15 @@ bool ChannelManager::kickFromChannel(Client* kicker, const std::string& channelN
         return false;
     
     // Trouver le client cible
-    Client* target = NULL;
-    for (std::map<int, Client*>::const_iterator it = _server->getClientManager()->getClients().begin(); 
-         it != _server->getClientManager()->getClients().end(); ++it) {
-        if (AuthHandler::compareNicknames(it->second->getNickname(), targetNick) && it->second->isRegistered()) {
-            target = it->second;
-            break;
-        }
-    }
+    Client* target = _server->getClientManager()->findByNick(targetNick);
+    if (target && !target->isRegistered())
+        target = NULL;
     
     if (!target || !channel->isMember(target))
         return false;
     
     // Envoyer le message KICK
-    std::string kickMsg = kicker->getPrefix() + " KICK " + channelName + " " + targetNick + " :" + reason;
+    std::string kickMsg = kicker->getPrefix() + " KICK " + channel->getName() + " " + targetNick + " :" + reason;
     channel->broadcast(kickMsg, NULL); // À tous y compris le target qui est kicked
     
     // Retirer du canal
@@ -208,7 +215,7 @@ bool ChannelManager::kickFromChannel(Client* kicker, const std::string& channelN
 }
 
 bool ChannelManager::inviteToChannel(Client* inviter, const std::string& channelName, const std::string& targetNick) {
-    if (!inviter || !isValidChannelName(channelName))
+    if (!inviter)
         return false;
     
     Channel* channel = getChannel(channelName);
@@ -224,14 +231,9 @@ bool ChannelManager::inviteToChannel(Client* inviter, const std::string& channel
         return false;
     
     // Trouver le client cible
-    Client* target = NULL;
-    for (std::map<int, Client*>::const_iterator it = _server->getClientManager()->getClients().begin(); 
-         it != _server->getClientManager()->getClients().end(); ++it) {
-        if (AuthHandler::compareNicknames(it->second->getNickname(), targetNick) && it->second->isRegistered()) {
-            target = it->second;
-            break;
-        }
-    }
+    Client* target = _server->getClientManager()->findByNick(targetNick);
+    if (target && !target->isRegistered())
+        target = NULL;
     
     if (!target)
         return false;
@@ -244,18 +246,17 @@ bool ChannelManager::inviteToChannel(Client* inviter, const std::string& channel
     channel->addInvite(target);
     
     // Notifier l'inviter
-    std::string replyMsg = ":ft_irc.42.fr 341 " + inviter->getNickname() + " " + targetNick + " " + channelName;
-    inviter->sendMessage(replyMsg);
+    Reply::send(inviter, Reply::RPL_INVITING, target->getNickname(), channel->getName());
     
     // Notifier le target
-    std::string inviteMsg = inviter->getPrefix() + " INVITE " + targetNick + " :" + channelName;
+    std::string inviteMsg = inviter->getPrefix() + " INVITE " + targetNick + " :" + channel->getName();
     target->sendMessage(inviteMsg);
     
     return true;
 }
 
 bool ChannelManager::setChannelTopic(Client* client, const std::string& channelName, const std::string& topic) {
-    if (!client || !isValidChannelName(channelName))
+    if (!client)
         return false;
     
     Channel* channel = getChannel(channelName);
@@ -269,11 +270,9 @@ bool ChannelManager::setChannelTopic(Client* client, const std::string& channelN
     // Si pas de topic fourni, afficher le topic actuel
     if (topic.empty()) {
         if (channel->getTopic().empty()) {
-            std::string replyMsg = ":ft_irc.42.fr 331 " + client->getNickname() + " " + channelName + " :No topic is set";
-            client->sendMessage(replyMsg);
+            Reply::send(client, Reply::RPL_NOTOPIC, channel->getName());
         } else {
-            std::string replyMsg = ":ft_irc.42.fr 332 " + client->getNickname() + " " + channelName + " :" + channel->getTopic();
-            client->sendMessage(replyMsg);
+            Reply::send(client, Reply::RPL_TOPIC, channel->getName(), channel->getTopic());
         }
         return true;
     }
@@ -286,14 +285,14 @@ bool ChannelManager::setChannelTopic(Client* client, const std::string& channelN
     channel->setTopic(topic);
     
     // Notifier tous les membres
-    std::string topicMsg = client->getPrefix() + " TOPIC " + channelName + " :" + topic;
+    std::string topicMsg = client->getPrefix() + " TOPIC " + channel->getName() + " :" + topic;
     channel->broadcast(topicMsg, NULL); // À tous y compris le client qui change le topic
     
     return true;
 }
 
 bool ChannelManager::setChannelMode(Client* client, const std::string& channelName, const std::string& modeString, const std::vector<std::string>& params) {
-    if (!client || !isValidChannelName(channelName))
+    if (!client)
         return false;
     
     Channel* channel = getChannel(channelName);
@@ -308,8 +307,7 @@ bool ChannelManager::setChannelMode(Client* client, const std::string& channelNa
     if (modeString.empty()) {
         std::string modeStr = channel->getModeString();
         if (modeStr.empty()) modeStr = "+";
-        std::string replyMsg = ":ft_irc.42.fr 324 " + client->getNickname() + " " + channelName + " " + modeStr;
-        client->sendMessage(replyMsg);
+        Reply::send(client, Reply::RPL_CHANNELMODEIS, channel->getName(), modeStr);
         return true;
     }
     
@@ -373,16 +371,11 @@ bool ChannelManager::setChannelMode(Client* client, const std::string& channelNa
             case 'o': // operator
                 if (paramIndex < params.size()) {
                     std::string targetNick = params[paramIndex++];
-                    Client* target = NULL;
                     
                     // Trouver le client cible
-                    for (std::map<int, Client*>::const_iterator it = _server->getClientManager()->getClients().begin(); 
-                         it != _server->getClientManager()->getClients().end(); ++it) {
-                        if (AuthHandler::compareNicknames(it->second->getNickname(), targetNick) && it->second->isRegistered()) {
-                            target = it->second;
-                            break;
-                        }
-                    }
+                    Client* target = _server->getClientManager()->findByNick(targetNick);
+                    if (target && !target->isRegistered())
+                        target = NULL;
                     
                     if (target && channel->isMember(target)) {
                         if (adding) {
@@ -400,7 +393,7 @@ bool ChannelManager::setChannelMode(Client* client, const std::string& channelNa
     
     // Notifier tous les membres du changement de mode
     if (!appliedModes.empty()) {
-        std::string modeMsg = client->getPrefix() + " MODE " + channelName + " " + appliedModes + appliedParams;
+        std::string modeMsg = client->getPrefix() + " MODE " + channel->getName() + " " + appliedModes + appliedParams;
         channel->broadcast(modeMsg, NULL); // À tous y compris le client qui change le mode
     }
     
@@ -410,30 +403,44 @@ bool ChannelManager::setChannelMode(Client* client, const std::string& channelNa
 void ChannelManager::broadcastQuit(Client* client, const std::string& reason) {
     if (!client) return;
     
-    std::string quitMsg = client->getPrefix() + " QUIT :" + reason;
+    WireBuffer quitMsg(client->getPrefix() + " QUIT :" + reason);
     
-    // Envoyer le QUIT à tous les canaux où le client est membre
-    for (std::map<std::string, Channel*>::iterator it = _channels.begin(); it != _channels.end(); ++it) {
-        if (it->second->isMember(client)) {
-            it->second->broadcast(quitMsg, client); // Ne pas renvoyer au client qui quit
-        }
-    }
+    // Une seule copie par utilisateur partageant au moins un canal
+    sendToCommonChannels(client, quitMsg);
 }
 
 void ChannelManager::broadcastNickChange(Client* client, const std::string& oldNick, const std::string& newNick) {
     if (!client) return;
     
-    std::string nickMsg = ":" + oldNick + "!" + client->getUsername() + "@" + client->getHostname() + " NICK :" + newNick;
+    WireBuffer nickMsg(":" + oldNick + "!" + client->getUsername() + "@" + client->getHostname() + " NICK :" + newNick);
     
-    // Envoyer le changement de nick à tous les canaux où le client est membre
-    for (std::map<std::string, Channel*>::iterator it = _channels.begin(); it != _channels.end(); ++it) {
-        if (it->second->isMember(client)) {
-            it->second->broadcast(nickMsg, NULL); // À tous y compris le client
-        }
-    }
+    // Le pseudo figure dans les listes NAMES en cache
+    const std::vector<Client::ChannelLink>& channels = client->getChannels();
+    for (size_t i = 0; i < channels.size(); ++i)
+        channels[i].channel->invalidateNames();
+    
+    // Une seule copie par utilisateur partageant au moins un canal
+    sendToCommonChannels(client, nickMsg);
     
     // Envoyer aussi au client lui-même
-    client->sendMessage(nickMsg);
+    client->sendBuffer(nickMsg);
+}
+
+void ChannelManager::sendToCommonChannels(Client* client, const WireBuffer& buffer) {
+    const std::vector<Client::ChannelLink>& channels = client->getChannels();
+    if (channels.empty())
+        return;
+    
+    // Nouvelle époque : aucun client n'est marqué, pas d'ensemble à vider
+    ++_fanoutEpoch;
+    client->markFanout(_fanoutEpoch);
+    
+    _recipients.clear();
+    for (size_t i = 0; i < channels.size(); ++i)
+        channels[i].channel->collectRecipients(_recipients, _fanoutEpoch);
+    
+    for (size_t i = 0; i < _recipients.size(); ++i)
+        _recipients[i]->sendBuffer(buffer);
 }
 
 // Statistiques et utilitaires
@@ -443,52 +450,45 @@ size_t ChannelManager::getChannelCount() const {
 
 std::vector<std::string> ChannelManager::getChannelList() const {
     std::vector<std::string> list;
-    for (std::map<std::string, Channel*>::const_iterator it = _channels.begin(); it != _channels.end(); ++it) {
-        list.push_back(it->first);
+    for (size_t i = 0; i < _channels.size(); ++i) {
+        list.push_back(_channels[i]->getName());
     }
     return list;
 }
 
 std::vector<Channel*> ChannelManager::getClientChannels(Client* client) const {
     std::vector<Channel*> clientChannels;
+    if (!client)
+        return clientChannels;
     
-    for (std::map<std::string, Channel*>::const_iterator it = _channels.begin(); it != _channels.end(); ++it) {
-        if (it->second->isMember(client)) {
-            clientChannels.push_back(it->second);
-        }
-    }
-    
+    const std::vector<Client::ChannelLink>& links = client->getChannels();
+    for (size_t i = 0; i < links.size(); ++i)
+        clientChannels.push_back(links[i].channel);
     return clientChannels;
 }
 
 void ChannelManager::removeClientFromAllChannels(Client* client) {
     if (!client) return;
     
-    std::vector<std::string> toRemove;
-    
-    for (std::map<std::string, Channel*>::iterator it = _channels.begin(); it != _channels.end(); ++it) {
-        if (it->second->isMember(client)) {
-            it->second->removeMember(client);
-            
-            // Marquer pour suppression si vide
-            if (it->second->getMemberCount() == 0) {
-                toRemove.push_back(it->first);
-            }
+    // removeMember retire le canal de la liste du client : dépiler par la fin
+    const std::vector<Client::ChannelLink>& channels = client->getChannels();
+    while (!channels.empty()) {
+        Channel* channel = channels.back().channel;
+        channel->removeMember(client);
+        
+        // Supprimer le canal s'il est vide
+        if (channel->getMemberCount() == 0) {
+            removeChannel(channel);
         }
     }
-    
-    // Supprimer les canaux vides
-    for (size_t i = 0; i < toRemove.size(); ++i) {
-        removeChannel(toRemove[i]);
-    }
 }
 
 void ChannelManager::cleanupEmptyChannels() {
-    std::vector<std::string> toRemove;
+    std::vector<Channel*> toRemove;
     
-    for (std::map<std::string, Channel*>::iterator it = _channels.begin(); it != _channels.end(); ++it) {
-        if (it->second->getMemberCount() == 0) {
-            toRemove.push_back(it->first);
+    for (size_t i = 0; i < _channels.size(); ++i) {
+        if (_channels[i]->getMemberCount() == 0) {
+            toRemove.push_back(_channels[i]);
         }
     }
     
@@ -497,6 +497,6 @@ void ChannelManager::cleanupEmptyChannels() {
     }
 }
 
-const std::map<std::string, Channel*>& ChannelManager::getChannels() const {
+const std::vector<Channel*>& ChannelManager::getChannels() const {
     return _channels;
 }
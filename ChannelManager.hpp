@@ -3,6 +3,7 @@
 
 #include "Channel.hpp"
 #include "Client.hpp"
+#include "NameIndex.hpp"
 #include <map>
 #include <string>
 #include <vector>
@@ -11,8 +12,14 @@ class Server; // Forward declaration
 
 class ChannelManager {
 private:
-    std::map<std::string, Channel*> _channels;
+    NameIndex<Channel*> _channelIndex;  // Nom replié -> canal
+    std::vector<Channel*> _channels;    // Itération (position mémorisée dans Channel)
     Server *_server;
+    unsigned long _fanoutEpoch;         // Marqueur de visite, incrémenté à chaque diffusion
+    std::vector<Client*> _recipients;   // Réutilisé d'une diffusion à l'autre
+    
+    // Destinataires uniques des canaux du client (lui exclu)
+    void sendToCommonChannels(Client* client, const WireBuffer& buffer);
     
 public:
     ChannelManager(Server *server);
@@ -20,9 +27,9 @@ public:
     
     // Gestion des canaux
     Channel* createChannel(const std::string& name, Client* creator);
-    Channel* getChannel(const std::string& name);
-    void removeChannel(const std::string& name);
-    bool channelExists(const std::string& name) const;
+    Channel* getChannel(const StringView& name) const;
+    void removeChannel(Channel* channel);
+    bool channelExists(const StringView& name) const;
     
     // Validation
     bool isValidChannelName(const std::string& name) const;
@@ -37,6 +44,7 @@ public:
     
     // Messages
     bool sendToChannel(const std::string& channelName, const std::string& message, Client* sender);
+    bool sendToChannel(Channel* channel, const std::string& message, Client* sender);
     void broadcastQuit(Client* client, const std::string& reason);
     void broadcastNickChange(Client* client, const std::string& oldNick, const std::string& newNick);
     
@@ -50,7 +58,7 @@ public:
     void cleanupEmptyChannels();
     
     // Getters
-    const std::map<std::string, Channel*>& getChannels() const;
+    const std::vector<Channel*>& getChannels() const;
 };
 
 #endif
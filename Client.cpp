@@ -1,13 +1,27 @@
 #include "Client.hpp"
+#include "ClientManager.hpp"
+#include "Channel.hpp"
+#include "Clock.hpp"
 #include <sys/socket.h>
 #include <algorithm>
 #include <iostream>
+#include <cerrno>
+#include <cstring>
+#include <sys/uio.h>
 
 // Constructeur
-Client::Client(int fd) : _fd(fd), _state(CONNECTING), _passwordOk(false) {
-    _connectionTime = time(NULL);
-    _lastActivity = _connectionTime;
+Client::Client(int fd, ClientManager *manager)
+    : _fd(fd), _address(0), _sendOffset(0), _sendQueueBytes(0), _sendQueuePeak(0),
+      _sendqHighWater(0), _sendqMaxBytes(0), _sendqMaxMessages(0), _aboveHighWater(false),
+      _flushThreshold(0), _flushScheduled(false), _flushSlot(0), _writeArmed(false),
+      _runQueued(false), _runSlot(0), _readDeferred(false), _manager(manager),
+      _state(CONNECTING), _passwordOk(false), _closing(false), _ircOperator(false),
+      _lastActivity(Clock::now()), _connectionTime(Clock::wallTime()), _pingSentAt(0), _pingPending(false),
+      _floodTokens(0), _floodRefilledAt(Clock::now()), _fanoutEpoch(0) {
+    _livenessTimer.owner = this;
+    _floodTimer.owner = this;
     _hostname = "localhost"; // À adapter selon votre configuration
+    rebuildPrefix();
 }
 
 // Destructeur
@@ -19,24 +33,53 @@ const std::string& Client::getNickname() const { return _nickname; }
 const std::string& Client::getUsername() const { return _username; }
 const std::string& Client::getRealname() const { return _realname; }
 const std::string& Client::getHostname() const { return _hostname; }
-const std::string& Client::getBuffer() const { return _buffer; }
+uint32_t Client::getAddress() const { return _address; }
 ClientState Client::getState() const { return _state; }
 bool Client::isPasswordOk() const { return _passwordOk; }
-time_t Client::getLastActivity() const { return _lastActivity; }
+unsigned long Client::getLastActivity() const { return _lastActivity; }
 time_t Client::getConnectionTime() const { return _connectionTime; }
-const std::vector<std::string>& Client::getChannels() const { return _channels; }
+const std::vector<Client::ChannelLink>& Client::getChannels() const { return _channels; }
+Timer* Client::getLivenessTimer() { return &_livenessTimer; }
+bool Client::isPingPending() const { return _pingPending; }
+unsigned long Client::getPingSentAt() const { return _pingSentAt; }
+Timer* Client::getFloodTimer() { return &_floodTimer; }
+
+bool Client::isFloodThrottled() const {
+    return _floodTokens < 0;
+}
+
+unsigned long Client::getFloodWait(unsigned long ratePerSecond) const {
+    if (_floodTokens >= 0 || ratePerSecond == 0)
+        return 0;
+    // Jetons en millièmes : ratePerSecond millièmes regagnés par milliseconde
+    return (-_floodTokens + ratePerSecond - 1) / ratePerSecond;
+}
 
 bool Client::isRegistered() const {
     return _state == REGISTERED;
 }
 
+bool Client::isClosing() const {
+    return _closing;
+}
+
+bool Client::isIrcOperator() const {
+    return _ircOperator;
+}
+
 // Setters
 void Client::setNickname(const std::string& nickname) {
+    if (_nickname == nickname)
+        return;
     _nickname = nickname;
+    rebuildPrefix();
 }
 
 void Client::setUsername(const std::string& username) {
+    if (_username == username)
+        return;
     _username = username;
+    rebuildPrefix();
 }
 
 void Client::setRealname(const std::string& realname) {
@@ -44,7 +87,14 @@ void Client::setRealname(const std::string& realname) {
 }
 
 void Client::setHostname(const std::string& hostname) {
+    if (_hostname == hostname)
+        return;
     _hostname = hostname;
+    rebuildPrefix();
+}
+
+void Client::setAddress(uint32_t address) {
+    _address = address;
 }
 
 void Client::setState(ClientState state) {
@@ -56,56 +106,311 @@ void Client::setPasswordOk(bool ok) {
 }
 
 void Client::updateLastActivity() {
-    _lastActivity = time(NULL);
+    _lastActivity = Clock::now();
 }
 
-// Gestion du buffer
-void Client::appendToBuffer(const std::string& data) {
-    _buffer += data;
+void Client::markPingSent() {
+    _pingSentAt = Clock::now();
+    _pingPending = true;
 }
 
-std::string Client::extractMessage() {
-    size_t pos = _buffer.find("\r\n");
-    if (pos == std::string::npos) {
-        pos = _buffer.find("\n");
-        if (pos == std::string::npos)
-            return "";
+void Client::clearPingPending() {
+    _pingPending = false;
+}
+
+// Seau de jetons : plein à la connexion, regarni selon l'horloge en cache
+void Client::resetTokens(unsigned long burst) {
+    _floodTokens = burst * 1000;
+    _floodRefilledAt = Clock::now();
+}
+
+void Client::refillTokens(unsigned long ratePerSecond, unsigned long burst) {
+    unsigned long now = Clock::now();
+    long capacity = burst * 1000;
+    if (_floodTokens < capacity) {
+        long gained = (now - _floodRefilledAt) * ratePerSecond;
+        _floodTokens = (gained > capacity - _floodTokens) ? capacity : _floodTokens + gained;
     }
-    
-    std::string message = _buffer.substr(0, pos);
-    _buffer.erase(0, pos + (pos < _buffer.length() - 1 && _buffer[pos + 1] == '\n' ? 2 : 1));
-    return message;
+    _floodRefilledAt = now;
+}
+
+void Client::spendTokens(unsigned int cost) {
+    _floodTokens -= (long)cost * 1000;
+}
+
+void Client::markClosing() {
+    _closing = true;
+}
+
+// Seul mode utilisateur : +o, posé par OPER
+std::string Client::getModeString() const {
+    return _ircOperator ? "+o" : "+";
+}
+
+const char* Client::supportedModes() {
+    return "o";
+}
+
+void Client::setIrcOperator(bool oper) {
+    _ircOperator = oper;
+}
+
+// Gestion du buffer
+InputBuffer& Client::getInputBuffer() {
+    return _input;
+}
+
+bool Client::nextMessage(StringView& line) {
+    return _input.nextLine(line);
+}
+
+bool Client::hasPendingMessage() {
+    return _input.hasLine();
 }
 
 void Client::clearBuffer() {
-    _buffer.clear();
+    _input.clear();
 }
 
 // Gestion des canaux
-void Client::joinChannel(const std::string& channel) {
-    if (!isInChannel(channel)) {
-        _channels.push_back(channel);
+unsigned int Client::addChannelLink(Channel* channel, unsigned int memberSlot) {
+    ChannelLink link;
+    link.channel = channel;
+    link.memberSlot = memberSlot;
+    _channels.push_back(link);
+    return _channels.size() - 1;
+}
+
+// Échange avec le dernier lien : le canal concerné est informé de la nouvelle position
+void Client::removeChannelLink(unsigned int slot) {
+    if (slot != _channels.size() - 1) {
+        _channels[slot] = _channels.back();
+        _channels[slot].channel->setMemberClientSlot(_channels[slot].memberSlot, slot);
     }
+    _channels.pop_back();
+}
+
+void Client::setChannelLinkSlot(unsigned int slot, unsigned int memberSlot) {
+    _channels[slot].memberSlot = memberSlot;
 }
 
-void Client::leaveChannel(const std::string& channel) {
-    _channels.erase(std::remove(_channels.begin(), _channels.end(), channel), _channels.end());
+int Client::findChannelLink(const Channel* channel) const {
+    for (size_t i = 0; i < _channels.size(); ++i) {
+        if (_channels[i].channel == channel)
+            return _channels[i].memberSlot;
+    }
+    return -1;
 }
 
-bool Client::isInChannel(const std::string& channel) const {
-    return std::find(_channels.begin(), _channels.end(), channel) != _channels.end();
+bool Client::markFanout(unsigned long epoch) {
+    if (_fanoutEpoch == epoch)
+        return false;
+    _fanoutEpoch = epoch;
+    return true;
 }
 
 // Utilitaires
-std::string Client::getPrefix() const {
-    return ":" + _nickname + "!" + _username + "@" + _hostname;
+const std::string& Client::getPrefix() const {
+    return _prefix;
 }
 
-bool Client::isTimedOut(int timeout) const {
-    return (time(NULL) - _lastActivity) > timeout;
+// Appelé uniquement quand pseudo, user ou hôte change : aucune allocation par message
+void Client::rebuildPrefix() {
+    _prefix.clear();
+    _prefix.reserve(3 + _nickname.length() + _username.length() + _hostname.length());
+    _prefix += ":";
+    _prefix += _nickname;
+    _prefix += "!";
+    _prefix += _username;
+    _prefix += "@";
+    _prefix += _hostname;
 }
 
 void Client::sendMessage(const std::string& message) {
-    std::string fullMessage = message + "\r\n";
-    send(_fd, fullMessage.c_str(), fullMessage.length(), 0);
+    if (_closing)
+        return;
+    sendBuffer(WireBuffer(message));
+}
+
+// Mettre en file une ligne : rien n'est perdu sur écriture partielle ou EAGAIN
+// L'envoi est regroupé en fin de tick (un seul sendmsg pour toutes les lignes)
+void Client::sendBuffer(const WireBuffer& buffer) {
+    if (_closing || buffer.empty())
+        return;
+    
+    enqueue(buffer);
+    afterEnqueue();
+}
+
+// En-tête propre au destinataire + corps partagé (ex. 353 en cache)
+void Client::sendBuffer(const WireBuffer& head, const WireBuffer& body) {
+    if (_closing || body.empty())
+        return;
+    
+    enqueue(head);
+    enqueue(body);
+    afterEnqueue();
+}
+
+void Client::enqueue(const WireBuffer& buffer) {
+    _sendQueue.push_back(buffer);
+    _sendQueueBytes += buffer.length();
+    if (_sendQueueBytes > _sendQueuePeak)
+        _sendQueuePeak = _sendQueueBytes;
+}
+
+void Client::afterEnqueue() {
+    // Client lent : alerte au seuil haut, éviction à la limite dure
+    if (_sendqHighWater && !_aboveHighWater && _sendQueueBytes > _sendqHighWater) {
+        _aboveHighWater = true;
+        std::cerr << "Warning: sendq high-water reached for fd " << _fd
+                  << " (" << _sendQueueBytes << " bytes)" << std::endl;
+    }
+    if ((_sendqMaxBytes && _sendQueueBytes > _sendqMaxBytes) ||
+        (_sendqMaxMessages && _sendQueue.size() > _sendqMaxMessages)) {
+        discardPendingOutput();
+        if (_manager)
+            _manager->disconnectClient(_fd, "SendQ exceeded");
+        return;
+    }
+    
+    // Socket plein : on attend POLLOUT/EPOLLOUT
+    if (_writeArmed)
+        return;
+    
+    // Borne de latence : ne pas accumuler plus que le seuil avant d'écrire
+    if (!_manager || (_flushThreshold && _sendQueueBytes >= _flushThreshold)) {
+        if (!flushSendQueue()) {
+            if (_manager)
+                _manager->scheduleRemoval(_fd);
+            return;
+        }
+        if (_manager)
+            _manager->updateWriteInterest(this);
+        return;
+    }
+    
+    _manager->scheduleFlush(this);
+}
+
+// Envoyer autant que le socket l'accepte, sans jamais bloquer
+// Scatter-gather : jusqu'à MAX_IOV lignes par appel système
+bool Client::flushSendQueue() {
+    while (!_sendQueue.empty()) {
+        struct iovec iov[MAX_IOV];
+        size_t count = 0;
+        size_t total = 0;
+        
+        for (std::deque<WireBuffer>::const_iterator it = _sendQueue.begin();
+             it != _sendQueue.end() && count < MAX_IOV; ++it, ++count) {
+            size_t skip = (count == 0) ? _sendOffset : 0;
+            iov[count].iov_base = const_cast<char*>(it->data() + skip);
+            iov[count].iov_len = it->length() - skip;
+            total += iov[count].iov_len;
+        }
+        
+        struct msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        
+        ssize_t sent = sendmsg(_fd, &msg, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return true;
+            return false;
+        }
+        
+        // Consommer les lignes entièrement envoyées
+        _sendQueueBytes -= sent;
+        size_t remaining = sent;
+        while (remaining > 0) {
+            size_t left = _sendQueue.front().length() - _sendOffset;
+            if (remaining < left) {
+                _sendOffset += remaining;
+                break;
+            }
+            remaining -= left;
+            _sendQueue.pop_front();
+            _sendOffset = 0;
+        }
+        
+        // Écriture partielle : le socket est plein, inutile de réessayer
+        if ((size_t)sent < total)
+            return true;
+    }
+    _aboveHighWater = false;
+    return true;
+}
+
+void Client::setSendQueueLimits(size_t highWater, size_t maxBytes, size_t maxMessages) {
+    _sendqHighWater = highWater;
+    _sendqMaxBytes = maxBytes;
+    _sendqMaxMessages = maxMessages;
+}
+
+void Client::setFlushThreshold(size_t threshold) {
+    _flushThreshold = threshold;
+}
+
+bool Client::isFlushScheduled() const {
+    return _flushScheduled;
+}
+
+size_t Client::getFlushSlot() const {
+    return _flushSlot;
+}
+
+void Client::setFlushScheduled(bool scheduled, size_t slot) {
+    _flushScheduled = scheduled;
+    _flushSlot = slot;
+}
+
+bool Client::isRunQueued() const {
+    return _runQueued;
+}
+
+size_t Client::getRunSlot() const {
+    return _runSlot;
+}
+
+void Client::setRunQueued(bool queued, size_t slot) {
+    _runQueued = queued;
+    _runSlot = slot;
+}
+
+bool Client::isReadDeferred() const {
+    return _readDeferred;
+}
+
+void Client::setReadDeferred(bool deferred) {
+    _readDeferred = deferred;
+}
+
+// Abandonner la file, sauf la ligne partiellement envoyée (cadrage du flux)
+void Client::discardPendingOutput() {
+    size_t keep = (_sendOffset > 0) ? 1 : 0;
+    while (_sendQueue.size() > keep) {
+        _sendQueueBytes -= _sendQueue.back().length();
+        _sendQueue.pop_back();
+    }
+}
+
+size_t Client::getSendQueueBytes() const { return _sendQueueBytes; }
+size_t Client::getSendQueueMessages() const { return _sendQueue.size(); }
+size_t Client::getSendQueuePeak() const { return _sendQueuePeak; }
+size_t Client::getSendQueueMaxBytes() const { return _sendqMaxBytes; }
+
+bool Client::hasPendingOutput() const {
+    return !_sendQueue.empty();
+}
+
+bool Client::isWriteArmed() const {
+    return _writeArmed;
+}
+
+void Client::setWriteArmed(bool armed) {
+    _writeArmed = armed;
 }
\ No newline at end of file
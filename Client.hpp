@@ -3,7 +3,15 @@
 
 #include <string>
 #include <vector>
+#include <deque>
 #include <ctime>
+#include <stdint.h>
+#include "WireBuffer.hpp"
+#include "TimerWheel.hpp"
+#include "InputBuffer.hpp"
+
+class ClientManager; // Forward declaration
+class Channel;
 
 enum ClientState {
     CONNECTING,
@@ -14,22 +22,63 @@ enum ClientState {
 };
 
 class Client {
+public:
+    // Lien vers un canal rejoint : memberSlot = position dans les membres du canal
+    struct ChannelLink {
+        Channel *channel;
+        unsigned int memberSlot;
+    };
+
 private:
+    static const size_t MAX_IOV = 64;
+
+
     int _fd;
     std::string _nickname;
     std::string _username;
     std::string _realname;
     std::string _hostname;
-    std::string _buffer;
+    uint32_t _address;                      // IPv4 du pair (ordre hôte), clé d'admission
+    std::string _prefix;                    // ":nick!user@host", reconstruit au changement d'identité
+    InputBuffer _input;                     // Octets reçus (recv direct, lignes sans copie)
+    std::deque<WireBuffer> _sendQueue;     // Lignes sortantes partagées (CRLF inclus)
+    size_t _sendOffset;                     // Octets déjà envoyés de la première ligne
+    size_t _sendQueueBytes;                 // Octets en attente (offset déduit)
+    size_t _sendQueuePeak;
+    size_t _sendqHighWater;                 // Seuil d'alerte (octets)
+    size_t _sendqMaxBytes;                  // Limite dure (octets)
+    size_t _sendqMaxMessages;               // Limite dure (lignes)
+    bool _aboveHighWater;
+    size_t _flushThreshold;                 // Borne de latence : envoi anticipé (octets)
+    bool _flushScheduled;                   // Inscrit dans la liste de fin de tick
+    size_t _flushSlot;                      // Position dans cette liste
+    bool _writeArmed;                       // Intérêt écriture actif dans le backend
+    bool _runQueued;                        // Inscrit dans la file d'exécution des commandes
+    size_t _runSlot;                        // Position dans cette file
+    bool _readDeferred;                     // Lecture reportée tant que des lignes attendent
+    ClientManager *_manager;
     ClientState _state;
     bool _passwordOk;
-    time_t _lastActivity;
+    bool _closing;              // Tombstone : suppression différée en fin de tick
+    bool _ircOperator;          // Opérateur serveur (OPER)
+    unsigned long _lastActivity;            // Horloge en cache (ms monotones)
     time_t _connectionTime;
-    std::vector<std::string> _channels;
+    Timer _livenessTimer;                   // Inscription, PING sur inactivité, attente du PONG
+    unsigned long _pingSentAt;
+    bool _pingPending;                      // PING envoyé, PONG attendu
+    long _floodTokens;                      // Seau de jetons en millièmes ; négatif = fakelag
+    unsigned long _floodRefilledAt;
+    Timer _floodTimer;                      // Réveil quand le seau redevient positif
+    void enqueue(const WireBuffer& buffer);
+    void afterEnqueue();
+    void rebuildPrefix();
+
+    std::vector<ChannelLink> _channels;     // Canaux rejoints (tenu à jour par Channel)
+    unsigned long _fanoutEpoch;             // Dernière diffusion QUIT/NICK ayant visité ce client
 
 public:
     // Constructeurs et destructeur
-    Client(int fd);
+    Client(int fd, ClientManager *manager = NULL);
     ~Client();
     
     // Getters
@@ -38,37 +87,81 @@ public:
     const std::string& getUsername() const;
     const std::string& getRealname() const;
     const std::string& getHostname() const;
-    const std::string& getBuffer() const;
+    uint32_t getAddress() const;
     ClientState getState() const;
     bool isPasswordOk() const;
     bool isRegistered() const;
-    time_t getLastActivity() const;
+    bool isClosing() const;
+    bool isIrcOperator() const;
+    std::string getModeString() const;
+    static const char* supportedModes();    // Modes utilisateur (004)
+    unsigned long getLastActivity() const;
     time_t getConnectionTime() const;
-    const std::vector<std::string>& getChannels() const;
+    const std::vector<ChannelLink>& getChannels() const;
+    Timer* getLivenessTimer();
+    bool isPingPending() const;
+    unsigned long getPingSentAt() const;
+    Timer* getFloodTimer();
+    bool isFloodThrottled() const;
+    unsigned long getFloodWait(unsigned long ratePerSecond) const;     // ms avant de repasser à 0
     
     // Setters
     void setNickname(const std::string& nickname);
     void setUsername(const std::string& username);
     void setRealname(const std::string& realname);
     void setHostname(const std::string& hostname);
+    void setAddress(uint32_t address);
     void setState(ClientState state);
     void setPasswordOk(bool ok);
     void updateLastActivity();
+    void markPingSent();
+    void clearPingPending();
+    void resetTokens(unsigned long burst);
+    void refillTokens(unsigned long ratePerSecond, unsigned long burst);
+    void spendTokens(unsigned int cost);
+    void markClosing();
+    void setIrcOperator(bool oper);
     
     // Gestion du buffer
-    void appendToBuffer(const std::string& data);
-    std::string extractMessage();
+    InputBuffer& getInputBuffer();
+    bool nextMessage(StringView& line);
+    bool hasPendingMessage();
     void clearBuffer();
     
     // Gestion des canaux
-    void joinChannel(const std::string& channel);
-    void leaveChannel(const std::string& channel);
-    bool isInChannel(const std::string& channel) const;
+    // Index croisés avec Channel::_members (retraits en O(1))
+    unsigned int addChannelLink(Channel* channel, unsigned int memberSlot);
+    void removeChannelLink(unsigned int slot);
+    void setChannelLinkSlot(unsigned int slot, unsigned int memberSlot);
+    int findChannelLink(const Channel* channel) const;     // memberSlot, -1 si absent
+    bool markFanout(unsigned long epoch);   // false si déjà visité pour cette diffusion
     
     // Utilitaires
-    std::string getPrefix() const; // :nick!user@host
-    bool isTimedOut(int timeout) const;
+    const std::string& getPrefix() const; // :nick!user@host (en cache)
     void sendMessage(const std::string& message);
+    void sendBuffer(const WireBuffer& buffer);
+    void sendBuffer(const WireBuffer& head, const WireBuffer& body);    // Une ligne en deux morceaux
+    
+    // File d'envoi
+    bool flushSendQueue();          // false si erreur fatale sur le socket
+    bool hasPendingOutput() const;
+    bool isWriteArmed() const;
+    void setWriteArmed(bool armed);
+    void setSendQueueLimits(size_t highWater, size_t maxBytes, size_t maxMessages);
+    void setFlushThreshold(size_t threshold);
+    bool isFlushScheduled() const;
+    size_t getFlushSlot() const;
+    void setFlushScheduled(bool scheduled, size_t slot = 0);
+    bool isRunQueued() const;
+    size_t getRunSlot() const;
+    void setRunQueued(bool queued, size_t slot = 0);
+    bool isReadDeferred() const;
+    void setReadDeferred(bool deferred);
+    void discardPendingOutput();
+    size_t getSendQueueBytes() const;
+    size_t getSendQueueMessages() const;
+    size_t getSendQueuePeak() const;
+    size_t getSendQueueMaxBytes() const;
 };
 
 #endif
\ No newline at end of file
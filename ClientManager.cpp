@@ -1,13 +1,31 @@
 #include "ClientManager.hpp"
 #include "Server.hpp"
 #include "AuthHandler.hpp"
+#include "Clock.hpp"
+#include "Reply.hpp"
 #include <iostream>
 #include <algorithm>
 #include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
 
 // Constructeur
-ClientManager::ClientManager(Server *server, const std::string& password, int timeout)
-    : _server(server), _timeout(timeout) {
+ClientManager::ClientManager(Server *server, const std::string& password)
+    : _commandBudget(0), _server(server), _timers(100, Clock::now()),
+      _admission(server ? server->getConfig() : ServerConfig(), Clock::now()),
+      _registrationTimeout(30000), _pingInterval(120000), _pingTimeout(60000),
+      _floodRate(0), _floodBurst(0), _floodExcess(0), _recvqMax(0) {
+    if (_server) {
+        const ServerConfig& config = _server->getConfig();
+        _registrationTimeout = config.registrationTimeout * 1000;
+        _pingInterval = config.pingInterval * 1000;
+        _pingTimeout = config.pingTimeout * 1000;
+        _commandBudget = config.commandsPerTick;
+        _floodRate = config.floodRate;
+        _floodBurst = config.floodBurst;
+        _floodExcess = config.floodExcess;
+        _recvqMax = config.recvqMaxBytes;
+    }
     _authHandler = new AuthHandler(password, &_clients, server);
     // Note: _commandParser sera initialisé après la création du ChannelManager
     _commandParser = NULL;
@@ -26,20 +44,52 @@ ClientManager::~ClientManager() {
 }
 
 // Ajouter un nouveau client
-void ClientManager::addClient(int fd) {
+bool ClientManager::addClient(int fd, const sockaddr_in& addr) {
     if (_clients.find(fd) != _clients.end()) {
         std::cerr << "Warning: Client with fd " << fd << " already exists" << std::endl;
-        return;
+        return true;
+    }
+    
+    // Refus avant toute allocation de Client : ERROR au mieux (socket neuve, tampon vide), puis fermeture
+    std::string host = inet_ntoa(addr.sin_addr);
+    const char* refusal = _admission.admit(ntohl(addr.sin_addr.s_addr), Clock::now());
+    if (refusal) {
+        std::cout << "Connection refused from " << host << " (fd: " << fd << "): " << refusal << std::endl;
+        std::string line = "ERROR :Closing Link: " + host + " (" + refusal + ")\r\n";
+        send(fd, line.data(), line.length(), MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (_server)
+            _server->unregisterClient(fd);
+        close(fd);
+        return false;
     }
     
-    Client* newClient = new Client(fd);
+    Client* newClient = new Client(fd, this);
     _clients[fd] = newClient;
+    newClient->setAddress(ntohl(addr.sin_addr.s_addr));
+    newClient->setHostname(host);
+    
+    if (_server) {
+        const ServerConfig& config = _server->getConfig();
+        newClient->setSendQueueLimits(config.sendqHighWater, config.sendqMaxBytes, config.sendqMaxMessages);
+        newClient->setFlushThreshold(config.flushThreshold);
+    }
+    
+    newClient->resetTokens(_floodBurst);
+    
+    // Délai d'inscription ; devient ensuite le minuteur de PING
+    _timers.schedule(newClient->getLivenessTimer(), Clock::now() + _registrationTimeout);
     
     std::cout << "New client connected (fd: " << fd << ")" << std::endl;
     
     // Envoyer un message de notification de connexion
     newClient->sendMessage("NOTICE AUTH :*** Loading...");
     newClient->sendMessage("NOTICE AUTH :*** Connected!");
+    return true;
+}
+
+// Fin de PASS/NICK/USER : ne compte plus parmi les non inscrits
+void ClientManager::clientRegistered() {
+    _admission.registered();
 }
 
 // Supprimer un client
@@ -62,75 +112,254 @@ void ClientManager::removeClient(int fd) {
         std::cout << "Unregistered client disconnected (fd: " << fd << ")" << std::endl;
     }
     
+    if (!client->getNickname().empty() && findByNick(client->getNickname()) == client)
+        _nickIndex.erase(client->getNickname());
+    _admission.release(client->getAddress(), client->isRegistered(), Clock::now());
+    
+    // Dernière tentative d'envoi (ERROR, QUIT...) avant fermeture
+    client->flushSendQueue();
+    if (client->isFlushScheduled())
+        _pendingFlush[client->getFlushSlot()] = NULL;
+    if (client->isRunQueued())
+        _runQueue[client->getRunSlot()] = NULL;
+    
     delete client;
     _clients.erase(it);
+    
+    // Désinscrire du backend d'événements avant de libérer le fd
+    if (_server)
+        _server->unregisterClient(fd);
     close(fd);
 }
 
+// Marquer un client pour suppression en fin de tick
+// Évite de libérer un Client pendant qu'il est encore référencé (dispatch, broadcast)
+void ClientManager::scheduleRemoval(int fd) {
+    Client* client = getClient(fd);
+    if (!client || client->isClosing())
+        return;
+    
+    client->markClosing();
+    _pendingRemoval.push_back(fd);
+}
+
+// Supprimer les clients marqués : coût linéaire en nombre de déconnexions
+void ClientManager::reapClients() {
+    if (_pendingRemoval.empty())
+        return;
+    
+    std::vector<int> toRemove;
+    toRemove.swap(_pendingRemoval);
+    for (size_t i = 0; i < toRemove.size(); ++i) {
+        removeClient(toRemove[i]);
+    }
+}
+
 // Récupérer un client par fd
 Client* ClientManager::getClient(int fd) {
     std::map<int, Client*>::iterator it = _clients.find(fd);
     return (it != _clients.end()) ? it->second : NULL;
 }
 
-// Traiter les données reçues d'un client
-void ClientManager::handleClientData(int fd, const std::string& data) {
-    Client* client = getClient(fd);
-    if (!client)
+// Rechercher un client par nickname (insensible à la casse IRC)
+Client* ClientManager::findByNick(const StringView& nickname) const {
+    return _nickIndex.find(nickname);
+}
+
+// Changer le nickname d'un client en maintenant l'index
+void ClientManager::setNickname(Client* client, const std::string& nickname) {
+    if (!client->getNickname().empty() && findByNick(client->getNickname()) == client)
+        _nickIndex.erase(client->getNickname());
+    client->setNickname(nickname);
+    _nickIndex.insert(nickname, client);
+}
+
+// Mémoire bornée par connexion : au-delà de la limite, le pair est déconnecté
+bool ClientManager::checkRecvQueue(Client* client) {
+    // L'examen du buffer ramène d'abord une ligne inachevée à sa taille maximale
+    client->hasPendingMessage();
+    if (!_recvqMax || client->getInputBuffer().size() <= _recvqMax)
+        return true;
+    client->clearBuffer();
+    disconnectClient(client->getFd(), "RecvQ exceeded");
+    return false;
+}
+
+// Inscrire un client en fin de file d'exécution (une seule fois)
+void ClientManager::scheduleCommands(Client* client) {
+    if (client->isRunQueued() || client->isClosing())
+        return;
+    client->setRunQueued(true, _runQueue.size());
+    _runQueue.push_back(client);
+}
+
+// Un tour de tourniquet : chaque client inscrit traite au plus _commandBudget
+// lignes ; le reste attend dans son buffer et le client repasse en fin de file.
+// Un client bavard ne retarde donc les autres que d'un budget par tick.
+void ClientManager::runCommandQueue() {
+    if (_runQueue.empty() || !_commandParser)
+        return;
+    
+    _running.swap(_runQueue);
+    for (size_t i = 0; i < _running.size(); ++i) {
+        Client* client = _running[i];
+        if (!client)
+            continue;
+        client->setRunQueued(false);
+        if (client->isClosing())
+            continue;
+        
+        if (_floodRate)
+            client->refillTokens(_floodRate, _floodBurst);
+        
+        // Si processClientBuffer retourne false, le client doit être déconnecté
+        if (!_commandParser->processClientBuffer(client, _commandBudget)) {
+            scheduleRemoval(client->getFd());
+            continue;
+        }
+        if (client->isClosing())
+            continue;
+        
+        // Fakelag : les lignes restent en buffer jusqu'au réveil du minuteur ;
+        // la lecture continue pour mesurer l'excès
+        if (client->isFloodThrottled() && client->hasPendingMessage()) {
+            if (client->getInputBuffer().size() > _floodExcess) {
+                disconnectClient(client->getFd(), "Excess Flood");
+                continue;
+            }
+            _timers.schedule(client->getFloodTimer(), Clock::now() + client->getFloodWait(_floodRate));
+            if (client->isReadDeferred()) {
+                client->setReadDeferred(false);
+                if (_server)
+                    _server->resumeRead(client->getFd());
+            }
+            continue;
+        }
+        
+        if (client->hasPendingMessage()) {
+            scheduleCommands(client);
+        } else if (client->isReadDeferred()) {
+            // Backlog vidé : reprendre la lecture laissée dans le noyau
+            client->setReadDeferred(false);
+            if (_server)
+                _server->resumeRead(client->getFd());
+        }
+    }
+    _running.clear();
+}
+
+bool ClientManager::hasPendingCommands() const {
+    return !_runQueue.empty();
+}
+
+// N'armer POLLOUT/EPOLLOUT que tant que la file d'envoi n'est pas vide
+void ClientManager::updateWriteInterest(Client* client) {
+    if (!client || client->isClosing() || !_server)
         return;
     
-    // Ajouter les données au buffer
-    client->appendToBuffer(data);
+    bool wanted = client->hasPendingOutput();
+    if (wanted == client->isWriteArmed())
+        return;
     
-    // Traiter les messages complets
-    processClientMessages(fd);
+    _server->setWriteInterest(client->getFd(), wanted);
+    client->setWriteArmed(wanted);
 }
 
-// Traiter tous les messages dans le buffer d'un client
-void ClientManager::processClientMessages(int fd) {
+// Le socket est de nouveau inscriptible : vider la file
+void ClientManager::handleClientWritable(int fd) {
     Client* client = getClient(fd);
-    if (!client)
+    if (!client || client->isClosing())
         return;
     
-    // Si processClientBuffer retourne false, le client doit être déconnecté
-    if (!_commandParser->processClientBuffer(client)) {
-        removeClient(fd);
+    if (!client->flushSendQueue()) {
+        scheduleRemoval(fd);
+        return;
     }
+    updateWriteInterest(client);
 }
 
-// Vérifier les timeouts
-void ClientManager::checkTimeouts() {
-    std::vector<int> toDisconnect;
-    
-    for (std::map<int, Client*>::iterator it = _clients.begin(); it != _clients.end(); ++it) {
-        Client* client = it->second;
+// Inscrire un client pour l'envoi groupé de fin de tick
+void ClientManager::scheduleFlush(Client* client) {
+    if (client->isFlushScheduled())
+        return;
+    client->setFlushScheduled(true, _pendingFlush.size());
+    _pendingFlush.push_back(client);
+}
+
+// Fin de tick : un seul envoi scatter-gather par client ayant de la sortie
+void ClientManager::flushPendingOutput() {
+    for (size_t i = 0; i < _pendingFlush.size(); ++i) {
+        Client* client = _pendingFlush[i];
+        if (!client)
+            continue;
+        client->setFlushScheduled(false);
+        if (client->isClosing() || client->isWriteArmed())
+            continue;
         
-        // Timeout pour clients non-enregistrés (30 secondes)
-        if (!client->isRegistered() && client->isTimedOut(30)) {
-            toDisconnect.push_back(it->first);
+        if (!client->flushSendQueue()) {
+            scheduleRemoval(client->getFd());
             continue;
         }
-        
-        // Timeout pour clients enregistrés
-        if (client->isRegistered() && client->isTimedOut(_timeout)) {
-            _authHandler->handleTimeout(client);
-            toDisconnect.push_back(it->first);
+        updateWriteInterest(client);
+    }
+    _pendingFlush.clear();
+}
+
+// Minuteurs échus depuis le tick précédent : O(échéances), pas O(clients)
+void ClientManager::runTimers() {
+    _admission.expire(Clock::now());
+    _timers.advance(Clock::now());
+    
+    Timer* timer;
+    while ((timer = _timers.popExpired()) != NULL) {
+        Client* client = static_cast<Client*>(timer->owner);
+        if (timer == client->getFloodTimer())
+            scheduleCommands(client);   // Fin du fakelag : reprendre les lignes en attente
+        else
+            handleLivenessTimer(client);
+    }
+}
+
+// L'activité ne réarme pas le minuteur : on recalcule l'échéance à son expiration
+void ClientManager::handleLivenessTimer(Client* client) {
+    if (client->isClosing())
+        return;
+    
+    if (!client->isRegistered()) {
+        disconnectClient(client->getFd(), "Registration timeout");
+        return;
+    }
+    
+    // PONG reçu (ou tout autre trafic depuis le PING) : le pair est vivant
+    if (client->isPingPending()) {
+        if (client->getLastActivity() <= client->getPingSentAt()) {
+            disconnectClient(client->getFd(), "Ping timeout");
+            return;
         }
+        client->clearPingPending();
     }
     
-    // Déconnecter les clients en timeout
-    for (std::vector<int>::iterator it = toDisconnect.begin(); it != toDisconnect.end(); ++it) {
-        disconnectClient(*it, "Ping timeout");
+    unsigned long now = Clock::now();
+    unsigned long idleDeadline = client->getLastActivity() + _pingInterval;
+    if (idleDeadline > now) {
+        _timers.schedule(client->getLivenessTimer(), idleDeadline);
+        return;
     }
+    
+    client->sendMessage("PING :" + Reply::serverName());
+    client->markPingSent();
+    _timers.schedule(client->getLivenessTimer(), now + _pingTimeout);
 }
 
 // Déconnecter un client avec une raison
 void ClientManager::disconnectClient(int fd, const std::string& reason) {
     Client* client = getClient(fd);
-    if (client && !reason.empty()) {
+    if (!client || client->isClosing())
+        return;
+    if (!reason.empty()) {
         client->sendMessage("ERROR :" + reason);
     }
-    removeClient(fd);
+    scheduleRemoval(fd);
 }
 
 // Obtenir le nombre de clients
@@ -169,21 +398,19 @@ bool ClientManager::isValidFd(int fd) const {
 
 // Envoyer un message à tous les clients enregistrés
 void ClientManager::broadcastToAll(const std::string& message) {
+    WireBuffer buffer(message);
     for (std::map<int, Client*>::iterator it = _clients.begin(); it != _clients.end(); ++it) {
         if (it->second->isRegistered()) {
-            it->second->sendMessage(message);
+            it->second->sendBuffer(buffer);
         }
     }
 }
 
 // Envoyer un message à un client par nickname
 void ClientManager::sendToNick(const std::string& nickname, const std::string& message) {
-    for (std::map<int, Client*>::iterator it = _clients.begin(); it != _clients.end(); ++it) {
-        if (AuthHandler::compareNicknames(it->second->getNickname(), nickname) && it->second->isRegistered()) {
-            it->second->sendMessage(message);
-            return;
-        }
-    }
+    Client* target = findByNick(nickname);
+    if (target && target->isRegistered())
+        target->sendMessage(message);
 }
 
 // Getter pour les clients
@@ -191,10 +418,14 @@ const std::map<int, Client*>& ClientManager::getClients() const {
     return _clients;
 }
 
+const Admission& ClientManager::getAdmission() const {
+    return _admission;
+}
+
 // Initialisation différée du CommandParser
 void ClientManager::initializeCommandParser(ChannelManager *channelManager) {
     if (_commandParser) {
         delete _commandParser;
     }
-    _commandParser = new CommandParser(_authHandler, &_clients, channelManager);
+    _commandParser = new CommandParser(_authHandler, &_clients, channelManager, _server);
 }
\ No newline at end of file
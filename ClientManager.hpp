@@ -4,6 +4,10 @@
 #include "Client.hpp"
 #include "AuthHandler.hpp"
 #include "CommandParser.hpp"
+#include "NameIndex.hpp"
+#include "TimerWheel.hpp"
+#include "Admission.hpp"
+#include <netinet/in.h>
 #include <map>
 #include <vector>
 
@@ -12,26 +16,59 @@ class Server; // Forward declaration
 class ClientManager {
 private:
     std::map<int, Client*> _clients;
+    NameIndex<Client*> _nickIndex;      // Nick replié -> client (seul chemin de recherche par nick)
+    std::vector<int> _pendingRemoval;   // Tombstones compactés une fois par tick
+    std::vector<Client*> _pendingFlush; // Clients avec sortie à envoyer en fin de tick
+    std::vector<Client*> _runQueue;     // Clients ayant des lignes complètes (tourniquet)
+    std::vector<Client*> _running;      // File du tick en cours d'exécution
+    size_t _commandBudget;              // Lignes traitées par client et par tick (0 = illimité)
     AuthHandler *_authHandler;
     CommandParser *_commandParser;
     Server *_server;
-    int _timeout;
+    TimerWheel _timers;                 // Un minuteur de vivacité par client
+    Admission _admission;               // Limites par adresse source, avant création du Client
+    unsigned long _registrationTimeout; // ms
+    unsigned long _pingInterval;        // ms d'inactivité avant PING
+    unsigned long _pingTimeout;         // ms d'attente du PONG
+    unsigned long _floodRate;           // Jetons regagnés par seconde (0 = sans contrôle)
+    unsigned long _floodBurst;          // Capacité du seau
+    size_t _floodExcess;                // Octets en attente sous fakelag avant "Excess Flood"
+    size_t _recvqMax;                   // Octets reçus non traités (limite dure)
+    
+    void handleLivenessTimer(Client* client);
     
 public:
-    ClientManager(Server *server, const std::string& password, int timeout = 300);
+    ClientManager(Server *server, const std::string& password);
     ~ClientManager();
     
     // Gestion des clients
-    void addClient(int fd);
+    bool addClient(int fd, const sockaddr_in& addr);    // false : refusée et fermée
+    void clientRegistered();
     void removeClient(int fd);
+    void scheduleRemoval(int fd);
+    void reapClients();
     Client* getClient(int fd);
     
+    // Index des nicknames (enregistrés ou non)
+    Client* findByNick(const StringView& nickname) const;
+    void setNickname(Client* client, const std::string& nickname);
+    
     // Traitement des données
-    void handleClientData(int fd, const std::string& data);
-    void processClientMessages(int fd);
+    bool checkRecvQueue(Client* client);    // false : client déconnecté
+    
+    // Équité : chaque client traite au plus _commandBudget lignes par tick
+    void scheduleCommands(Client* client);
+    void runCommandQueue();
+    bool hasPendingCommands() const;
+    
+    // Sortie : armer/désarmer l'intérêt écriture selon l'état de la file
+    void updateWriteInterest(Client* client);
+    void handleClientWritable(int fd);
+    void scheduleFlush(Client* client);
+    void flushPendingOutput();
     
     // Maintenance
-    void checkTimeouts();
+    void runTimers();
     void disconnectClient(int fd, const std::string& reason = "");
     
     // Statistiques
@@ -46,6 +83,7 @@ public:
     
     // Getters
     const std::map<int, Client*>& getClients() const;
+    const Admission& getAdmission() const;
     
     // Initialisation différée du CommandParser
     void initializeCommandParser(ChannelManager *channelManager);
@@ -0,0 +1,12 @@
+#include "Clock.hpp"
+#include <time.h>
+
+unsigned long Clock::_monotonicMs = 0;
+time_t Clock::_wallTime = 0;
+
+void Clock::update() {
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+        _monotonicMs = (unsigned long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+    _wallTime = time(NULL);
+}
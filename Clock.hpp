@@ -0,0 +1,20 @@
+#ifndef CLOCK_HPP
+#define CLOCK_HPP
+
+#include <ctime>
+
+// Horloge mise en cache une fois par tick de la boucle principale
+// Les chemins chauds (activité, minuteurs, seaux de jetons) lisent la valeur
+// en cache au lieu d'appeler time()/clock_gettime() à chaque message.
+class Clock {
+private:
+    static unsigned long _monotonicMs;  // CLOCK_MONOTONIC, millisecondes
+    static time_t _wallTime;            // Heure murale (affichage, dates de création)
+
+public:
+    static void update();
+    static unsigned long now() { return _monotonicMs; }
+    static time_t wallTime() { return _wallTime; }
+};
+
+#endif
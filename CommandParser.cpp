@@ -1,300 +1,355 @@
 #include "CommandParser.hpp"
 #include "ChannelManager.hpp"
 #include "AuthHandler.hpp"
+#include "Server.hpp"
+#include "CaseMapping.hpp"
+#include "Reply.hpp"
 #include <sstream>
 #include <algorithm>
 #include <iostream>
+#include <cstring>
 
-// Constructeur IRCMessage
-IRCMessage::IRCMessage(const std::string& raw) {
-    std::istringstream iss(raw);
-    std::string token;
-    
-    // Vérifier s'il y a un préfixe
-    if (raw[0] == ':') {
-        iss >> prefix;
-        prefix = prefix.substr(1); // Enlever le ':'
+// FNV-1a sur le nom de commande
+static size_t hashName(const StringView& name) {
+    size_t hash = 2166136261u;
+    for (size_t i = 0; i < name.length; ++i) {
+        hash ^= static_cast<unsigned char>(name.data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Table de dispatch, dans l'ordre de CommandId
+const CommandParser::CommandEntry CommandParser::COMMANDS[CommandParser::CMD_COUNT] = {
+    { "PASS",    CMD_PASS,    1, false, 1, &CommandParser::handlePass },
+    { "NICK",    CMD_NICK,    0, false, 2, &CommandParser::handleNick },
+    { "USER",    CMD_USER,    4, false, 1, &CommandParser::handleUser },
+    { "PRIVMSG", CMD_PRIVMSG, 2, true,  1, &CommandParser::handlePrivmsg },
+    { "JOIN",    CMD_JOIN,    1, true,  2, &CommandParser::handleJoin },
+    { "PART",    CMD_PART,    1, true,  2, &CommandParser::handlePart },
+    { "PING",    CMD_PING,    0, false, 1, &CommandParser::handlePing },
+    { "PONG",    CMD_PONG,    0, false, 0, &CommandParser::handlePong },
+    { "QUIT",    CMD_QUIT,    0, false, 0, &CommandParser::handleQuit },
+    { "KICK",    CMD_KICK,    2, true,  2, &CommandParser::handleKick },
+    { "INVITE",  CMD_INVITE,  2, true,  2, &CommandParser::handleInvite },
+    { "TOPIC",   CMD_TOPIC,   1, true,  2, &CommandParser::handleTopic },
+    { "MODE",    CMD_MODE,    1, true,  2, &CommandParser::handleMode },
+    { "OPER",    CMD_OPER,    2, true,  1, &CommandParser::handleOper },
+    { "STATS",   CMD_STATS,   0, true,  2, &CommandParser::handleStats },
+    { "WHO",     CMD_WHO,     0, true,  2, &CommandParser::handleWho }
+};
+
+// Nom de commande (déjà en majuscules) -> CommandId
+// Table de hachage à adressage ouvert construite une fois depuis COMMANDS :
+// un hachage FNV-1a puis, en pratique, une seule comparaison.
+CommandParser::CommandId CommandParser::lookupCommand(const StringView& name) {
+    static const size_t SLOTS = 64;
+    static int slots[SLOTS];
+    static bool built = false;
+    
+    if (!built) {
+        for (size_t i = 0; i < SLOTS; ++i)
+            slots[i] = -1;
+        for (size_t i = 0; i < CMD_COUNT; ++i) {
+            StringView key(COMMANDS[i].name, std::strlen(COMMANDS[i].name));
+            size_t slot = hashName(key) & (SLOTS - 1);
+            while (slots[slot] != -1)
+                slot = (slot + 1) & (SLOTS - 1);
+            slots[slot] = i;
+        }
+        built = true;
     }
     
-    // Lire la commande
-    if (iss >> command) {
-        std::transform(command.begin(), command.end(), command.begin(), ::toupper);
-    }
-    
-    // Lire les paramètres
-    std::string remaining;
-    std::getline(iss, remaining);
-    if (!remaining.empty() && remaining[0] == ' ')
-        remaining = remaining.substr(1);
-    
-    if (!remaining.empty()) {
-        params = CommandParser::splitParams(remaining);
+    size_t slot = hashName(name) & (SLOTS - 1);
+    while (slots[slot] != -1) {
+        const CommandEntry& entry = COMMANDS[slots[slot]];
+        if (name == entry.name)
+            return entry.id;
+        slot = (slot + 1) & (SLOTS - 1);
     }
+    return CMD_UNKNOWN;
 }
 
 // Constructeur CommandParser
-CommandParser::CommandParser(AuthHandler *authHandler, std::map<int, Client*> *clients, ChannelManager *channelManager)
-    : _authHandler(authHandler), _clients(clients), _channelManager(channelManager) {}
+CommandParser::CommandParser(AuthHandler *authHandler, std::map<int, Client*> *clients, ChannelManager *channelManager, Server *server)
+    : _authHandler(authHandler), _clients(clients), _channelManager(channelManager), _server(server),
+      _floodControl(server && server->getConfig().floodRate > 0) {}
 
 // Destructeur
 CommandParser::~CommandParser() {}
 
-// Parser un message IRC
-IRCMessage CommandParser::parseMessage(const std::string& raw) {
-    return IRCMessage(raw);
-}
-
-// Séparer les paramètres (méthode statique)
-std::vector<std::string> CommandParser::splitParams(const std::string& params) {
-    std::vector<std::string> result;
-    std::istringstream iss(params);
-    std::string token;
-    
-    while (iss >> token) {
-        if (token[0] == ':') {
-            // Paramètre final (trailing parameter)
-            std::string trailing = token.substr(1);
-            std::string remaining;
-            std::getline(iss, remaining);
-            if (!remaining.empty())
-                trailing += remaining;
-            result.push_back(trailing);
-            break;
-        } else {
-            result.push_back(token);
-        }
-    }
-    
-    return result;
-}
-
 // Traiter un message
-bool CommandParser::processMessage(Client* client, const std::string& message) {
+bool CommandParser::processMessage(Client* client, const StringView& message) {
     if (message.empty())
         return true;
     
-    IRCMessage msg = parseMessage(message);
-    
-    if (msg.command.empty())
+    IRCMessage& msg = _message;
+    if (!msg.parse(message))
         return true;
     
     client->updateLastActivity();
     
-    // Commandes d'authentification
-    if (msg.command == "PASS" || msg.command == "NICK" || msg.command == "USER") {
-        return handleAuthCommand(client, msg);
-    }
+    CommandId id = lookupCommand(msg.command);
     
-    // Vérifier si le client est enregistré pour les autres commandes
-    if (!client->isRegistered()) {
-        _authHandler->sendNumericReply(client, 451, "You have not registered");
-        return false;
-    }
+    // Seau de jetons : le coût est prélevé même si la commande échoue (opérateurs exemptés)
+    if (_floodControl && !client->isIrcOperator())
+        client->spendTokens(id == CMD_UNKNOWN ? 1 : COMMANDS[id].cost);
     
-    // Autres commandes (PING, QUIT, etc.)
-    return handleGeneralCommand(client, msg);
-}
-
-// Gérer les commandes d'authentification
-bool CommandParser::handleAuthCommand(Client* client, const IRCMessage& msg) {
-    if (msg.command == "PASS") {
-        return _authHandler->handlePass(client, msg.params);
-    }
-    else if (msg.command == "NICK") {
-        return _authHandler->handleNick(client, msg.params);
+    // Plus de 512 octets (CRLF compris) : rejetée plutôt qu'exécutée tronquée
+    if (msg.truncated) {
+        Reply::send(client, Reply::ERR_INPUTTOOLONG);
+        return true;
     }
-    else if (msg.command == "USER") {
-        return _authHandler->handleUser(client, msg.params);
+    if (id == CMD_UNKNOWN) {
+        if (!client->isRegistered())
+            Reply::send(client, Reply::ERR_NOTREGISTERED);
+        else
+            Reply::send(client, Reply::ERR_UNKNOWNCOMMAND, msg.command);
+        return true;
     }
     
-    return false;
-}
-
-// Gérer les commandes générales
-bool CommandParser::handleGeneralCommand(Client* client, const IRCMessage& msg) {
-    if (msg.command == "PING") {
-        std::string response = "PONG :ft_irc.42.fr";
-        if (!msg.params.empty())
-            response = "PONG :" + msg.params[0];
-        client->sendMessage(response);
+    // Vérifications communes avant tout handler
+    const CommandEntry& entry = COMMANDS[id];
+    if (entry.needsRegistration && !client->isRegistered()) {
+        Reply::send(client, Reply::ERR_NOTREGISTERED);
         return true;
     }
-    else if (msg.command == "QUIT") {
-        return handleQuit(client, msg.params);
-    }
-    else if (msg.command == "JOIN") {
-        return handleJoin(client, msg.params);
-    }
-    else if (msg.command == "PART") {
-        return handlePart(client, msg.params);
-    }
-    else if (msg.command == "PRIVMSG") {
-        return handlePrivmsg(client, msg.params);
-    }
-    else if (msg.command == "KICK") {
-        return handleKick(client, msg.params);
-    }
-    else if (msg.command == "INVITE") {
-        return handleInvite(client, msg.params);
-    }
-    else if (msg.command == "TOPIC") {
-        return handleTopic(client, msg.params);
-    }
-    else if (msg.command == "MODE") {
-        return handleMode(client, msg.params);
-    }
-    else if (msg.command == "WHO") {
-        _authHandler->sendNumericReply(client, 315, "End of WHO list");
+    if (msg.params.size() < entry.minParams) {
+        Reply::send(client, Reply::ERR_NEEDMOREPARAMS, StringView(entry.name, std::strlen(entry.name)));
         return true;
     }
     
-    // Commande non reconnue
-    _authHandler->sendNumericReply(client, 421, msg.command + " :Unknown command");
+    bool handled = (this->*entry.handler)(client, msg.params);
+    
+    // Seul QUIT ferme la connexion ; les autres échecs ont déjà répondu
+    return handled || id != CMD_QUIT;
+}
+
+// Commandes d'authentification
+bool CommandParser::handlePass(Client* client, const MessageParams& params) {
+    return _authHandler->handlePass(client, params);
+}
+
+bool CommandParser::handleNick(Client* client, const MessageParams& params) {
+    return _authHandler->handleNick(client, params);
+}
+
+bool CommandParser::handleUser(Client* client, const MessageParams& params) {
+    return _authHandler->handleUser(client, params);
+}
+
+bool CommandParser::handleOper(Client* client, const MessageParams& params) {
+    return _authHandler->handleOper(client, params);
+}
+
+// Commande PING
+bool CommandParser::handlePing(Client* client, const MessageParams& params) {
+    std::string response = "PONG :" + Reply::serverName();
+    if (!params.empty())
+        response = "PONG :" + params[0].str();
+    client->sendMessage(response);
+    return true;
+}
+
+// Commande PONG : réponse à notre PING d'inactivité
+bool CommandParser::handlePong(Client* client, const MessageParams& params) {
+    (void)params;
+    client->clearPingPending();
+    return true;
+}
+
+// Commande WHO
+bool CommandParser::handleWho(Client* client, const MessageParams& params) {
+    Reply::send(client, Reply::RPL_ENDOFWHO, params.empty() ? StringView("*", 1) : params[0]);
     return true;
 }
 
 // Commande JOIN
-bool CommandParser::handleJoin(Client* client, const std::vector<std::string>& params) {
-    if (params.empty()) {
-        _authHandler->sendNumericReply(client, 461, "JOIN :Not enough parameters");
-        return false;
-    }
-    
-    std::string channelName = params[0];
-    std::string key = (params.size() > 1) ? params[1] : "";
+bool CommandParser::handleJoin(Client* client, const MessageParams& params) {
+    std::string channelName = params[0].str();
+    std::string key = (params.size() > 1) ? params[1].str() : "";
     
     return _channelManager->joinChannel(client, channelName, key);
 }
 
 // Commande PART
-bool CommandParser::handlePart(Client* client, const std::vector<std::string>& params) {
-    if (params.empty()) {
-        _authHandler->sendNumericReply(client, 461, "PART :Not enough parameters");
-        return false;
-    }
-    
-    std::string channelName = params[0];
-    std::string reason = (params.size() > 1) ? params[1] : "";
+bool CommandParser::handlePart(Client* client, const MessageParams& params) {
+    std::string channelName = params[0].str();
+    std::string reason = (params.size() > 1) ? params[1].str() : "";
     
     return _channelManager->partChannel(client, channelName, reason);
 }
 
 // Commande PRIVMSG
-bool CommandParser::handlePrivmsg(Client* client, const std::vector<std::string>& params) {
-    if (params.size() < 2) {
-        _authHandler->sendNumericReply(client, 461, "PRIVMSG :Not enough parameters");
-        return false;
-    }
-    
-    std::string target = params[0];
-    std::string message = params[1];
+bool CommandParser::handlePrivmsg(Client* client, const MessageParams& params) {
+    // Cible résolue sur la tranche reçue : les chaînes ne sont construites
+    // que pour un message effectivement livré (ou une erreur)
+    const StringView& target = params[0];
+    const StringView& message = params[1];
     
     // Message vers un canal
-    if (target[0] == '#' || target[0] == '&') {
-        std::string fullMsg = client->getPrefix() + " PRIVMSG " + target + " :" + message;
-        return _channelManager->sendToChannel(target, fullMsg, client);
+    if (!target.empty() && (target[0] == '#' || target[0] == '&')) {
+        Channel* channel = _channelManager->getChannel(target);
+        if (!channel) {
+            Reply::send(client, Reply::ERR_NOSUCHCHANNEL, target);
+            return false;
+        }
+        // Une seule allocation : préfixe en cache, ligne construite en place
+        const std::string& prefix = client->getPrefix();
+        std::string fullMsg;
+        fullMsg.reserve(prefix.length() + 9 + channel->getName().length() + 2 + message.length);
+        fullMsg += prefix;
+        fullMsg += " PRIVMSG ";
+        fullMsg += channel->getName();
+        fullMsg += " :";
+        fullMsg.append(message.data, message.length);
+        return _channelManager->sendToChannel(channel, fullMsg, client);
     }
     
     // Message privé vers un utilisateur
-    Client* targetClient = NULL;
-    for (std::map<int, Client*>::iterator it = _clients->begin(); it != _clients->end(); ++it) {
-        if (AuthHandler::compareNicknames(it->second->getNickname(), target) && it->second->isRegistered()) {
-            targetClient = it->second;
-            break;
-        }
-    }
+    Client* targetClient = _server->getClientManager()->findByNick(target);
+    if (targetClient && !targetClient->isRegistered())
+        targetClient = NULL;
     
     if (!targetClient) {
-        _authHandler->sendNumericReply(client, 401, target + " :No such nick/channel");
+        Reply::send(client, Reply::ERR_NOSUCHNICK, target);
         return false;
     }
     
     // Envoyer le message privé
-    std::string fullMsg = client->getPrefix() + " PRIVMSG " + target + " :" + message;
+    std::string fullMsg = client->getPrefix() + " PRIVMSG " + target.str() + " :" + message.str();
     targetClient->sendMessage(fullMsg);
     return true;
 }
 
 // Commande KICK
-bool CommandParser::handleKick(Client* client, const std::vector<std::string>& params) {
-    if (params.size() < 2) {
-        _authHandler->sendNumericReply(client, 461, "KICK :Not enough parameters");
-        return false;
-    }
-    
-    std::string channelName = params[0];
-    std::string targetNick = params[1];
-    std::string reason = (params.size() > 2) ? params[2] : client->getNickname();
+bool CommandParser::handleKick(Client* client, const MessageParams& params) {
+    std::string channelName = params[0].str();
+    std::string targetNick = params[1].str();
+    std::string reason = (params.size() > 2) ? params[2].str() : client->getNickname();
     
     return _channelManager->kickFromChannel(client, channelName, targetNick, reason);
 }
 
-bool CommandParser::handleInvite(Client* client, const std::vector<std::string>& params) {
-    if (params.size() < 2) {
-        _authHandler->sendNumericReply(client, 461, "INVITE :Not enough parameters");
-        return false;
-    }
-    
-    std::string targetNick = params[0];
-    std::string channelName = params[1];
+bool CommandParser::handleInvite(Client* client, const MessageParams& params) {
+    std::string targetNick = params[0].str();
+    std::string channelName = params[1].str();
     
     return _channelManager->inviteToChannel(client, channelName, targetNick);
 }
 
-bool CommandParser::handleTopic(Client* client, const std::vector<std::string>& params) {
-    if (params.empty()) {
-        _authHandler->sendNumericReply(client, 461, "TOPIC :Not enough parameters");
-        return false;
-    }
-    
-    std::string channelName = params[0];
-    std::string topic = (params.size() > 1) ? params[1] : "";
+bool CommandParser::handleTopic(Client* client, const MessageParams& params) {
+    std::string channelName = params[0].str();
+    std::string topic = (params.size() > 1) ? params[1].str() : "";
     
     return _channelManager->setChannelTopic(client, channelName, topic);
 }
 
-bool CommandParser::handleMode(Client* client, const std::vector<std::string>& params) {
-    if (params.empty()) {
-        _authHandler->sendNumericReply(client, 461, "MODE :Not enough parameters");
-        return false;
-    }
-    
-    std::string target = params[0];
+bool CommandParser::handleMode(Client* client, const MessageParams& params) {
+    std::string target = params[0].str();
     
     // Mode utilisateur
-    if (AuthHandler::compareNicknames(target, client->getNickname())) {
-        _authHandler->sendNumericReply(client, 221, "+");
+    if (CaseMapping::equals(target, client->getNickname())) {
+        Reply::send(client, Reply::RPL_UMODEIS, client->getModeString());
         return true;
     }
     
     // Mode canal
     if (target[0] == '#' || target[0] == '&') {
-        std::string modeString = (params.size() > 1) ? params[1] : "";
+        std::string modeString = (params.size() > 1) ? params[1].str() : "";
         std::vector<std::string> modeParams;
         
         // Récupérer les paramètres supplémentaires
         for (size_t i = 2; i < params.size(); ++i) {
-            modeParams.push_back(params[i]);
+            modeParams.push_back(params[i].str());
         }
         
         return _channelManager->setChannelMode(client, target, modeString, modeParams);
     }
     
-    _authHandler->sendNumericReply(client, 401, target + " :No such nick/channel");
+    Reply::send(client, Reply::ERR_NOSUCHNICK, target);
     return false;
 }
 
-// Traiter le buffer d'un client
-bool CommandParser::processClientBuffer(Client* client) {
-    std::string message;
-    while (!(message = client->extractMessage()).empty()) {
-        if (!processMessage(client, message)) {
-            // Si processMessage retourne false, le client doit être déconnecté
-			if (message == "QUIT") {
-					return false; // Le client doit être déconnecté
-				}
-            return true;
+// Commande STATS (opérateurs) : q = profondeur des files d'envoi
+bool CommandParser::handleStats(Client* client, const MessageParams& params) {
+    std::string query = params.empty() ? "*" : params[0].str();
+    
+    if (!client->isIrcOperator()) {
+        Reply::send(client, Reply::ERR_NOPRIVILEGES);
+        return true;
+    }
+    
+    if (query == "q") {
+        size_t totalBytes = 0;
+        size_t totalMessages = 0;
+        
+        for (std::map<int, Client*>::iterator it = _clients->begin(); it != _clients->end(); ++it) {
+            Client* target = it->second;
+            totalBytes += target->getSendQueueBytes();
+            totalMessages += target->getSendQueueMessages();
+            
+            // Ne lister que les files non vides
+            if (target->getSendQueueMessages() == 0)
+                continue;
+            
+            std::ostringstream oss;
+            oss << (target->getNickname().empty() ? "*" : target->getNickname())
+                << " fd=" << target->getFd()
+                << " sendq=" << target->getSendQueueBytes() << "/" << target->getSendQueueMaxBytes()
+                << " msgs=" << target->getSendQueueMessages()
+                << " peak=" << target->getSendQueuePeak();
+            Reply::send(client, Reply::RPL_STATSDEBUG, oss.str());
+        }
+        
+        std::ostringstream total;
+        total << "total sendq=" << totalBytes << " msgs=" << totalMessages
+              << " clients=" << _clients->size();
+        Reply::send(client, Reply::RPL_STATSDEBUG, total.str());
+    }
+    else if (query == "a" && _server) {
+        // Compteurs d'acceptation du listener
+        AcceptStats stats = _server->getAcceptStats();
+        std::ostringstream oss;
+        oss << "accept accepted=" << stats.accepted
+            << " batches=" << stats.batches
+            << " caphits=" << stats.capHits
+            << " fdexhausted=" << stats.fdExhausted
+            << " errors=" << stats.errors
+            << " queue=" << _server->getAcceptQueueDepth();
+        Reply::send(client, Reply::RPL_STATSDEBUG, oss.str());
+        
+        unsigned long overflows = 0;
+        unsigned long drops = 0;
+        if (Listener::readKernelOverflows(overflows, drops)) {
+            std::ostringstream kernel;
+            kernel << "kernel listenoverflows=" << overflows << " listendrops=" << drops;
+            Reply::send(client, Reply::RPL_STATSDEBUG, kernel.str());
         }
+        
+        const Admission& admission = _server->getClientManager()->getAdmission();
+        std::ostringstream limits;
+        limits << "admission tracked=" << admission.getTrackedCount()
+               << " unregistered=" << admission.getUnregistered()
+               << " refused=" << admission.getRefusedCount();
+        Reply::send(client, Reply::RPL_STATSDEBUG, limits.str());
+    }
+    
+    Reply::send(client, Reply::RPL_ENDOFSTATS, query);
+    return true;
+}
+
+// Traiter le buffer d'un client
+bool CommandParser::processClientBuffer(Client* client, size_t budget) {
+    StringView message;
+    size_t processed = 0;
+    while ((budget == 0 || processed < budget) && !client->isFloodThrottled() && client->nextMessage(message)) {
+        ++processed;
+        // Si processMessage retourne false, le client doit être déconnecté
+        if (!processMessage(client, message))
+            return false;
+        if (client->isClosing())
+            break;
     }
     return true; // Le client peut continuer
 }
@@ -307,14 +362,14 @@ std::string CommandParser::toUpper(const std::string& str) {
 }
 
 // Commande QUIT
-bool CommandParser::handleQuit(Client* client, const std::vector<std::string>& params) {
+bool CommandParser::handleQuit(Client* client, const MessageParams& params) {
     if (!client)
         return false;
     
     // Extraire la raison du QUIT
     std::string reason = "Client Quit";
     if (!params.empty())
-        reason = params[0];
+        reason = params[0].str();
     
     std::cout << "Client " << client->getNickname() << " quit: " << reason << std::endl;
     
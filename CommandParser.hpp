@@ -6,57 +6,94 @@
 #include <map>
 #include "Client.hpp"
 #include "AuthHandler.hpp"
+#include "StringView.hpp"
+#include "IRCMessage.hpp"
 
 // Forward declarations
 class CommandParser;
 class Channel;
 class ChannelManager;
-
-struct IRCMessage {
-    std::string prefix;
-    std::string command;
-    std::vector<std::string> params;
-    
-    IRCMessage() {}
-    IRCMessage(const std::string& raw);
-};
+class Server;
 
 class CommandParser {
+public:
+    // Identifiant compact attribué à l'analyse (index dans la table des commandes)
+    enum CommandId {
+        CMD_PASS,
+        CMD_NICK,
+        CMD_USER,
+        CMD_PRIVMSG,
+        CMD_JOIN,
+        CMD_PART,
+        CMD_PING,
+        CMD_PONG,
+        CMD_QUIT,
+        CMD_KICK,
+        CMD_INVITE,
+        CMD_TOPIC,
+        CMD_MODE,
+        CMD_OPER,
+        CMD_STATS,
+        CMD_WHO,
+        CMD_COUNT,
+        CMD_UNKNOWN = CMD_COUNT
+    };
+
 private:
+    typedef bool (CommandParser::*Handler)(Client* client, const MessageParams& params);
+    
+    // Entrée de la table de dispatch : ajouter une commande = ajouter une entrée
+    struct CommandEntry {
+        const char *name;
+        CommandId id;
+        size_t minParams;           // En dessous : 461 sans appeler le handler
+        bool needsRegistration;     // Client non enregistré : 451
+        unsigned int cost;          // Jetons prélevés (contrôle de flood)
+        Handler handler;
+    };
+    static const CommandEntry COMMANDS[CMD_COUNT];
+    
+    static CommandId lookupCommand(const StringView& name);
+    
     AuthHandler *_authHandler;
     std::map<int, Client*> *_clients;
     ChannelManager *_channelManager; // AJOUT NÉCESSAIRE
+    Server *_server;
     
-    // Parsing
-    IRCMessage parseMessage(const std::string& raw);
+    IRCMessage _message;    // Réutilisé pour chaque ligne (aucune allocation)
+    bool _floodControl;     // Seaux de jetons actifs (FTIRC_FLOOD_RATE > 0)
     
-    // Gestion des commandes
-    bool handleAuthCommand(Client* client, const IRCMessage& msg);
-    bool handleGeneralCommand(Client* client, const IRCMessage& msg);
+    // Commandes d'authentification (déléguées à l'AuthHandler)
+    bool handlePass(Client* client, const MessageParams& params);
+    bool handleNick(Client* client, const MessageParams& params);
+    bool handleUser(Client* client, const MessageParams& params);
+    bool handleOper(Client* client, const MessageParams& params);
+    
+    bool handlePing(Client* client, const MessageParams& params);
+    bool handlePong(Client* client, const MessageParams& params);
+    bool handleWho(Client* client, const MessageParams& params);
     
     // NOUVELLES COMMANDES OBLIGATOIRES
-    bool handleJoin(Client* client, const std::vector<std::string>& params);
-    bool handlePart(Client* client, const std::vector<std::string>& params);
-    bool handlePrivmsg(Client* client, const std::vector<std::string>& params);
-    bool handleKick(Client* client, const std::vector<std::string>& params);
-    bool handleInvite(Client* client, const std::vector<std::string>& params);
-    bool handleTopic(Client* client, const std::vector<std::string>& params);
-    bool handleMode(Client* client, const std::vector<std::string>& params);
-    bool handleQuit(Client* client, const std::vector<std::string>& params);
+    bool handleJoin(Client* client, const MessageParams& params);
+    bool handlePart(Client* client, const MessageParams& params);
+    bool handlePrivmsg(Client* client, const MessageParams& params);
+    bool handleKick(Client* client, const MessageParams& params);
+    bool handleInvite(Client* client, const MessageParams& params);
+    bool handleTopic(Client* client, const MessageParams& params);
+    bool handleMode(Client* client, const MessageParams& params);
+    bool handleQuit(Client* client, const MessageParams& params);
+    bool handleStats(Client* client, const MessageParams& params);
 
 public:
-    CommandParser(AuthHandler *authHandler, std::map<int, Client*> *clients, ChannelManager *channelManager);
+    CommandParser(AuthHandler *authHandler, std::map<int, Client*> *clients, ChannelManager *channelManager, Server *server);
     ~CommandParser();
     
-    // Méthode statique pour être utilisée par IRCMessage
-    static std::vector<std::string> splitParams(const std::string& params);
-    
     // Traiter un message reçu d'un client
-    bool processMessage(Client* client, const std::string& message);
+    bool processMessage(Client* client, const StringView& message);
     
     // Traiter tous les messages en buffer d'un client
     // Retourne false si le client doit être déconnecté
-    bool processClientBuffer(Client* client);
+    bool processClientBuffer(Client* client, size_t budget = 0);   // budget 0 = tout le buffer ; s'arrête si le seau est vide
     
     // Utilitaires
     std::string toUpper(const std::string& str);
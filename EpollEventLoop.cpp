@@ -0,0 +1,82 @@
+#ifdef __linux__
+
+#include "EpollEventLoop.hpp"
+#include <unistd.h>
+#include <cstring>
+#include <stdexcept>
+
+EpollEventLoop::EpollEventLoop() : _epollFd(-1), _events(256) {
+    _epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (_epollFd == -1)
+        throw std::runtime_error("epoll_create1 failed");
+}
+
+EpollEventLoop::~EpollEventLoop() {
+    if (_epollFd != -1)
+        close(_epollFd);
+}
+
+uint32_t EpollEventLoop::toEpollEvents(unsigned int events) {
+    uint32_t epollEvents = EPOLLET | EPOLLRDHUP;
+    if (events & EVENT_READ)
+        epollEvents |= EPOLLIN;
+    if (events & EVENT_WRITE)
+        epollEvents |= EPOLLOUT;
+    return epollEvents;
+}
+
+bool EpollEventLoop::add(int fd, unsigned int events) {
+    epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.events = toEpollEvents(events);
+    ev.data.fd = fd;
+    return epoll_ctl(_epollFd, EPOLL_CTL_ADD, fd, &ev) == 0;
+}
+
+bool EpollEventLoop::modify(int fd, unsigned int events) {
+    epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.events = toEpollEvents(events);
+    ev.data.fd = fd;
+    return epoll_ctl(_epollFd, EPOLL_CTL_MOD, fd, &ev) == 0;
+}
+
+void EpollEventLoop::remove(int fd) {
+    // Argument ignoré depuis Linux 2.6.9 mais requis non-NULL avant
+    epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    epoll_ctl(_epollFd, EPOLL_CTL_DEL, fd, &ev);
+}
+
+int EpollEventLoop::wait(std::vector<IOEvent>& ready, int timeoutMs) {
+    ready.clear();
+
+    int count = epoll_wait(_epollFd, &_events[0], _events.size(), timeoutMs);
+    if (count <= 0)
+        return count;
+
+    for (int i = 0; i < count; ++i) {
+        IOEvent event;
+        event.fd = _events[i].data.fd;
+        event.events = 0;
+        if (_events[i].events & EPOLLIN)
+            event.events |= EVENT_READ;
+        if (_events[i].events & EPOLLOUT)
+            event.events |= EVENT_WRITE;
+        if (_events[i].events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP))
+            event.events |= EVENT_ERROR;
+        ready.push_back(event);
+    }
+
+    // Tableau plein : l'agrandir pour le prochain tour
+    if ((size_t)count == _events.size())
+        _events.resize(_events.size() * 2);
+
+    return count;
+}
+
+const char* EpollEventLoop::getName() const {
+    return "epoll";
+}
+
+#endif
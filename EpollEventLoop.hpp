@@ -0,0 +1,32 @@
+#ifndef EPOLLEVENTLOOP_HPP
+#define EPOLLEVENTLOOP_HPP
+
+#ifdef __linux__
+
+#include "EventLoop.hpp"
+#include <sys/epoll.h>
+#include <vector>
+
+// Backend Linux par défaut : epoll en mode edge-triggered
+// Le coût d'un réveil dépend du nombre de fds prêts, pas du nombre de connexions.
+class EpollEventLoop : public EventLoop {
+private:
+    int _epollFd;
+    std::vector<epoll_event> _events;
+
+    static uint32_t toEpollEvents(unsigned int events);
+
+public:
+    EpollEventLoop();
+    virtual ~EpollEventLoop();
+
+    virtual bool add(int fd, unsigned int events);
+    virtual bool modify(int fd, unsigned int events);
+    virtual void remove(int fd);
+    virtual int wait(std::vector<IOEvent>& ready, int timeoutMs);
+    virtual const char* getName() const;
+};
+
+#endif
+
+#endif
@@ -0,0 +1,19 @@
+#include "EventLoop.hpp"
+#include "PollEventLoop.hpp"
+#include "EpollEventLoop.hpp"
+#include <stdexcept>
+
+EventLoop* EventLoop::create(const std::string& backend) {
+    if (backend == "poll")
+        return new PollEventLoop();
+
+#ifdef __linux__
+    if (backend.empty() || backend == "epoll")
+        return new EpollEventLoop();
+#else
+    if (backend.empty())
+        return new PollEventLoop();
+#endif
+
+    throw std::runtime_error("Unknown event backend: " + backend);
+}
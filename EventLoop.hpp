@@ -0,0 +1,41 @@
+#ifndef EVENTLOOP_HPP
+#define EVENTLOOP_HPP
+
+#include <string>
+#include <vector>
+
+// Intérêts / événements portables entre les backends
+enum EventMask {
+    EVENT_READ  = 1 << 0,
+    EVENT_WRITE = 1 << 1,
+    EVENT_ERROR = 1 << 2
+};
+
+struct IOEvent {
+    int fd;
+    unsigned int events;
+};
+
+// Backend d'événements interchangeable (epoll, poll)
+// Les backends peuvent être edge-triggered : l'appelant doit toujours
+// vider un fd prêt (recv/accept jusqu'à EAGAIN).
+class EventLoop {
+public:
+    virtual ~EventLoop() {}
+
+    // Enregistrement des fds
+    virtual bool add(int fd, unsigned int events) = 0;
+    virtual bool modify(int fd, unsigned int events) = 0;
+    virtual void remove(int fd) = 0;
+
+    // Attendre des événements : remplit ready avec les seuls fds prêts
+    // Retourne le nombre d'événements, ou -1 (errno positionné)
+    virtual int wait(std::vector<IOEvent>& ready, int timeoutMs) = 0;
+
+    virtual const char* getName() const = 0;
+
+    // Fabrique : "epoll", "poll" ou "" (défaut de la plateforme)
+    static EventLoop* create(const std::string& backend);
+};
+
+#endif
@@ -0,0 +1,72 @@
+#include "IRCMessage.hpp"
+
+IRCMessage::IRCMessage() : truncated(false) {}
+
+bool IRCMessage::parse(const StringView& line) {
+    const char* p = line.data;
+    size_t length = line.length;
+
+    prefix = StringView();
+    command = StringView();
+    params.clear();
+    truncated = false;
+
+    // Limite RFC : 512 octets CRLF compris
+    if (length > MAX_LENGTH - 2) {
+        length = MAX_LENGTH - 2;
+        truncated = true;
+    }
+    const char* end = p + length;
+
+    while (p < end && *p == ' ')
+        ++p;
+
+    // Préfixe optionnel
+    if (p < end && *p == ':') {
+        const char* start = ++p;
+        while (p < end && *p != ' ')
+            ++p;
+        prefix = StringView(start, p - start);
+        while (p < end && *p == ' ')
+            ++p;
+    }
+
+    // Commande copiée en majuscules ; démesurée, elle est rendue telle quelle
+    // (jamais tronquée : aucune commande connue ne la reconnaîtra, d'où 421)
+    const char* commandStart = p;
+    while (p < end && *p != ' ')
+        ++p;
+    size_t commandLength = p - commandStart;
+    if (commandLength == 0)
+        return false;
+    if (commandLength > MAX_COMMAND_LENGTH) {
+        command = StringView(commandStart, commandLength);
+    } else {
+        for (size_t i = 0; i < commandLength; ++i) {
+            char c = commandStart[i];
+            _command[i] = (c >= 'a' && c <= 'z') ? c - ('a' - 'A') : c;
+        }
+        command = StringView(_command, commandLength);
+    }
+
+    // Paramètres : le dernier (':' ou 15e) prend le reste de la ligne
+    while (p < end) {
+        while (p < end && *p == ' ')
+            ++p;
+        if (p == end)
+            break;
+
+        if (*p == ':' || params.size() == MessageParams::MAX_PARAMS - 1) {
+            if (*p == ':')
+                ++p;
+            params.push(StringView(p, end - p));
+            break;
+        }
+
+        const char* start = p;
+        while (p < end && *p != ' ')
+            ++p;
+        params.push(StringView(start, p - start));
+    }
+    return true;
+}
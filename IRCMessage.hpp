@@ -0,0 +1,54 @@
+#ifndef IRCMESSAGE_HPP
+#define IRCMESSAGE_HPP
+
+#include "StringView.hpp"
+#include <cstddef>
+
+// Paramètres d'un message : tranches du buffer de réception (aucune allocation)
+class MessageParams {
+public:
+    static const size_t MAX_PARAMS = 15;    // RFC 1459 : 14 intermédiaires + 1 final
+
+private:
+    StringView _items[MAX_PARAMS];
+    size_t _count;
+
+public:
+    MessageParams() : _count(0) {}
+
+    size_t size() const { return _count; }
+    bool empty() const { return _count == 0; }
+    const StringView& operator[](size_t i) const { return _items[i]; }
+
+    void clear() { _count = 0; }
+    void push(const StringView& item) { _items[_count++] = item; }
+};
+
+// Message IRC analysé en une passe sur la ligne reçue
+// prefix et params pointent dans le buffer source ; command pointe dans une
+// copie interne en majuscules (d'où l'absence de copie de l'objet), sauf
+// au-delà de MAX_COMMAND_LENGTH où elle désigne le jeton source entier.
+class IRCMessage {
+public:
+    static const size_t MAX_LENGTH = 512;           // CRLF inclus
+    static const size_t MAX_COMMAND_LENGTH = 32;
+
+    StringView prefix;
+    StringView command;
+    MessageParams params;
+    bool truncated;             // Ligne coupée à MAX_LENGTH - 2 octets
+
+private:
+    char _command[MAX_COMMAND_LENGTH];
+
+    IRCMessage(const IRCMessage&);
+    IRCMessage& operator=(const IRCMessage&);
+
+public:
+    IRCMessage();
+
+    // Analyser une ligne sans terminateur ; false si aucune commande
+    bool parse(const StringView& line);
+};
+
+#endif
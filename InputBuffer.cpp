@@ -0,0 +1,95 @@
+#include "InputBuffer.hpp"
+#include <cstring>
+#include <cstdlib>
+#include <new>
+
+InputBuffer::InputBuffer() : _data(NULL), _capacity(0), _start(0), _end(0), _scan(0) {}
+
+InputBuffer::~InputBuffer() {
+    std::free(_data);
+}
+
+char* InputBuffer::prepare(size_t minimum) {
+    if (_capacity - _end >= minimum)
+        return _data + _end;
+
+    // Ramener les octets non consommés au début avant d'agrandir
+    size_t pending = _end - _start;
+    if (_start > 0) {
+        if (pending > 0)
+            std::memmove(_data, _data + _start, pending);
+        _scan -= _start;
+        _start = 0;
+        _end = pending;
+        if (_capacity - _end >= minimum)
+            return _data + _end;
+    }
+
+    size_t capacity = _capacity ? _capacity : INITIAL_CAPACITY;
+    while (capacity - _end < minimum)
+        capacity *= 2;
+    char* data = static_cast<char*>(std::realloc(_data, capacity));
+    if (!data)
+        throw std::bad_alloc();
+    _data = data;
+    _capacity = capacity;
+    return _data + _end;
+}
+
+size_t InputBuffer::writable() const {
+    return _capacity - _end;
+}
+
+void InputBuffer::commit(size_t count) {
+    _end += count;
+}
+
+// memchr (vectorisé par la libc) ne reparcourt jamais les octets déjà vus
+// Sans fin de ligne, [_start, _end) est une seule ligne inachevée : au-delà de
+// MAX_LINE octets, la suite est jetée (mémoire bornée quoi qu'envoie le pair)
+const char* InputBuffer::findNewline() {
+    if (_scan == _end)
+        return NULL;
+
+    const char* newline = static_cast<const char*>(
+        std::memchr(_data + _scan, '\n', _end - _scan));
+    if (newline)
+        return newline;
+
+    if (_end - _start > MAX_LINE)
+        _end = _start + MAX_LINE + 1;
+    _scan = _end;
+    return NULL;
+}
+
+bool InputBuffer::nextLine(StringView& line) {
+    const char* newline = findNewline();
+    if (!newline)
+        return false;
+
+    size_t lineEnd = newline - _data;
+    size_t length = lineEnd - _start;
+    if (length > 0 && _data[lineEnd - 1] == '\r')
+        --length;
+    line = StringView(_data + _start, length);
+
+    _start = lineEnd + 1;
+    _scan = _start;
+
+    // Buffer vidé : repartir du début sans copie
+    if (_start == _end)
+        _start = _end = _scan = 0;
+    return true;
+}
+
+bool InputBuffer::hasLine() {
+    return findNewline() != NULL;
+}
+
+size_t InputBuffer::size() const {
+    return _end - _start;
+}
+
+void InputBuffer::clear() {
+    _start = _end = _scan = 0;
+}
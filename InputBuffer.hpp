@@ -0,0 +1,47 @@
+#ifndef INPUTBUFFER_HPP
+#define INPUTBUFFER_HPP
+
+#include "StringView.hpp"
+#include <cstddef>
+
+// Buffer de réception contigu d'un client
+// recv écrit directement dans la zone libre ; les lignes complètes sont
+// rendues sous forme de tranches sans copie. Les octets consommés ne sont
+// déplacés qu'au moment où la place manque (une fois par remplissage, pas par ligne).
+class InputBuffer {
+private:
+    static const size_t INITIAL_CAPACITY = 4096;
+    static const size_t MAX_LINE = 512;     // Au-delà, la ligne inachevée est tronquée
+
+    char *_data;
+    size_t _capacity;
+    size_t _start;          // Début des octets non consommés
+    size_t _end;            // Fin des octets reçus
+    size_t _scan;           // Position déjà examinée (pas de '\n' avant)
+
+    InputBuffer(const InputBuffer&);
+    InputBuffer& operator=(const InputBuffer&);
+
+    const char* findNewline();
+
+public:
+    InputBuffer();
+    ~InputBuffer();
+
+    // Garantir au moins minimum octets libres contigus, retourner la zone d'écriture
+    char* prepare(size_t minimum);
+    size_t writable() const;
+    void commit(size_t count);
+
+    // Prochaine ligne complète sans son terminateur (\n ou \r\n)
+    // La tranche reste valide jusqu'au prochain prepare
+    // Une ligne démesurée est rendue avec ses MAX_LINE premiers octets et au
+    // moins un octet de plus (le parseur la signale, 417)
+    bool nextLine(StringView& line);
+    bool hasLine();         // Une ligne complète attend (sans la consommer)
+
+    size_t size() const;
+    void clear();
+};
+
+#endif
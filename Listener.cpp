@@ -0,0 +1,163 @@
+#include "Listener.hpp"
+#include <sys/socket.h>
+#include <netinet/tcp.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+
+AcceptStats::AcceptStats()
+    : accepted(0), batches(0), capHits(0), fdExhausted(0), errors(0) {}
+
+Listener::Listener(int port, int backlog, size_t maxPerTick)
+    : _fd(-1), _maxPerTick(maxPerTick), _backlogPending(false), _exhausted(false) {
+    _fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (_fd == -1)
+        throw std::runtime_error("Socket creation failed");
+
+    // Non-blocking
+    fcntl(_fd, F_SETFL, O_NONBLOCK);
+    fcntl(_fd, F_SETFD, FD_CLOEXEC);
+
+    // Réutiliser l'adresse
+    int opt = 1;
+    setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    // Configuration de l'adresse
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = INADDR_ANY;
+
+    if (bind(_fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(_fd);
+        throw std::runtime_error("Bind failed");
+    }
+
+    if (listen(_fd, backlog > 0 ? backlog : SOMAXCONN) < 0) {
+        close(_fd);
+        throw std::runtime_error("Listen failed");
+    }
+}
+
+Listener::~Listener() {
+    if (_fd != -1)
+        close(_fd);
+}
+
+int Listener::getFd() const {
+    return _fd;
+}
+
+size_t Listener::acceptBatch(std::vector<AcceptedConnection>& out) {
+    size_t count = 0;
+    _backlogPending = false;
+    _exhausted = false;
+
+    while (_maxPerTick == 0 || count < _maxPerTick) {
+        AcceptedConnection conn;
+        socklen_t len = sizeof(conn.addr);
+#ifdef __linux__
+        conn.fd = accept4(_fd, (sockaddr*)&conn.addr, &len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+        conn.fd = accept(_fd, (sockaddr*)&conn.addr, &len);
+        if (conn.fd >= 0) {
+            fcntl(conn.fd, F_SETFL, O_NONBLOCK);
+            fcntl(conn.fd, F_SETFD, FD_CLOEXEC);
+        }
+#endif
+
+        if (conn.fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+                // Edge-triggered : la file restante ne sera pas re-signalée
+                _exhausted = true;
+                ++_stats.fdExhausted;
+            } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                ++_stats.errors;
+            }
+            break;
+        }
+
+        out.push_back(conn);
+        ++count;
+    }
+
+    if (_maxPerTick != 0 && count == _maxPerTick) {
+        _backlogPending = true;
+        ++_stats.capHits;
+    }
+    if (count > 0) {
+        _stats.accepted += count;
+        ++_stats.batches;
+    }
+    return count;
+}
+
+bool Listener::hasBacklog() const {
+    return _backlogPending || _exhausted;
+}
+
+bool Listener::needsImmediateRetry() const {
+    return _backlogPending;
+}
+
+AcceptStats Listener::getStats() const {
+    return _stats;
+}
+
+long Listener::getQueueDepth() const {
+#ifdef __linux__
+    // Sur un socket en écoute, tcpi_unacked = longueur courante de la file d'accept
+    struct tcp_info info;
+    socklen_t len = sizeof(info);
+    if (getsockopt(_fd, IPPROTO_TCP, TCP_INFO, &info, &len) == 0)
+        return info.tcpi_unacked;
+#endif
+    return -1;
+}
+
+bool Listener::readKernelOverflows(unsigned long& overflows, unsigned long& drops) {
+    std::ifstream file("/proc/net/netstat");
+    if (!file)
+        return false;
+
+    // Deux lignes "TcpExt:" : noms puis valeurs
+    std::string names;
+    std::string values;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.compare(0, 7, "TcpExt:") != 0)
+            continue;
+        if (names.empty()) {
+            names = line;
+        } else {
+            values = line;
+            break;
+        }
+    }
+    if (values.empty())
+        return false;
+
+    std::istringstream nameStream(names);
+    std::istringstream valueStream(values);
+    std::string name;
+    std::string value;
+    bool found = false;
+    while (nameStream >> name && valueStream >> value) {
+        if (name == "ListenOverflows") {
+            overflows = std::strtoul(value.c_str(), NULL, 10);
+            found = true;
+        } else if (name == "ListenDrops") {
+            drops = std::strtoul(value.c_str(), NULL, 10);
+        }
+    }
+    return found;
+}
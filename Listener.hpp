@@ -0,0 +1,58 @@
+#ifndef LISTENER_HPP
+#define LISTENER_HPP
+
+#include <netinet/in.h>
+#include <vector>
+#include <cstddef>
+
+struct AcceptedConnection {
+    int fd;
+    sockaddr_in addr;
+};
+
+// Compteurs d'acceptation
+struct AcceptStats {
+    unsigned long accepted;     // Connexions acceptées
+    unsigned long batches;      // Appels à acceptBatch ayant accepté au moins une connexion
+    unsigned long capHits;      // Plafond par tick atteint : reste de la file reporté
+    unsigned long fdExhausted;  // EMFILE/ENFILE : file du listen laissée en attente
+    unsigned long errors;       // Autres erreurs d'accept
+
+    AcceptStats();
+};
+
+// Socket d'écoute non bloquant avec acceptation par lots
+// accept4(SOCK_NONBLOCK|SOCK_CLOEXEC) jusqu'à EAGAIN ou jusqu'au plafond par tick
+class Listener {
+private:
+    int _fd;
+    size_t _maxPerTick;
+    bool _backlogPending;       // Plafond atteint : reprendre sans attendre d'événement
+    bool _exhausted;            // Plus de fds : réessayer au tick suivant
+    AcceptStats _stats;
+
+    Listener(const Listener&);
+    Listener& operator=(const Listener&);
+
+public:
+    Listener(int port, int backlog, size_t maxPerTick);
+    ~Listener();
+
+    int getFd() const;
+
+    // Accepter un lot de connexions (ajoutées à out), retourne leur nombre
+    size_t acceptBatch(std::vector<AcceptedConnection>& out);
+
+    // Des connexions restent peut-être en file : l'appelant doit rappeler acceptBatch
+    bool hasBacklog() const;
+    bool needsImmediateRetry() const;
+
+    // Statistiques
+    AcceptStats getStats() const;
+    long getQueueDepth() const;     // Connexions en attente dans la file du noyau (-1 si inconnu)
+
+    // Compteurs globaux du noyau (/proc/net/netstat), false si indisponibles
+    static bool readKernelOverflows(unsigned long& overflows, unsigned long& drops);
+};
+
+#endif
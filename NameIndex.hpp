@@ -0,0 +1,122 @@
+#ifndef NAMEINDEX_HPP
+#define NAMEINDEX_HPP
+
+#include "CaseMapping.hpp"
+#include <string>
+#include <vector>
+
+// Table de hachage à adressage ouvert (sondage linéaire) indexée par nom IRC
+// Les clés sont stockées repliées (casemapping) : "Alice" et "aLICE"
+// désignent la même entrée. La recherche replie à la volée et n'alloue rien.
+template <typename V>
+class NameIndex {
+private:
+    enum SlotState { EMPTY, USED, DELETED };
+
+    struct Slot {
+        std::string key;        // Nom replié
+        size_t hash;
+        V value;
+        SlotState state;
+
+        Slot() : hash(0), value(), state(EMPTY) {}
+    };
+
+    std::vector<Slot> _slots;
+    size_t _count;
+    size_t _deleted;
+
+    static bool matches(const std::string& folded, const StringView& name) {
+        if (folded.length() != name.length)
+            return false;
+        for (size_t i = 0; i < name.length; ++i) {
+            if (static_cast<unsigned char>(folded[i]) != CaseMapping::fold(name.data[i]))
+                return false;
+        }
+        return true;
+    }
+
+    // Position de la clé, ou _slots.size() si absente
+    size_t locate(const StringView& name, size_t hash) const {
+        size_t mask = _slots.size() - 1;
+        size_t slot = hash & mask;
+        while (_slots[slot].state != EMPTY) {
+            const Slot& entry = _slots[slot];
+            if (entry.state == USED && entry.hash == hash && matches(entry.key, name))
+                return slot;
+            slot = (slot + 1) & mask;
+        }
+        return _slots.size();
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<Slot> old;
+        old.swap(_slots);
+        _slots.resize(capacity);
+        _count = 0;
+        _deleted = 0;
+        for (size_t i = 0; i < old.size(); ++i) {
+            if (old[i].state == USED)
+                place(old[i].key, old[i].hash, old[i].value);
+        }
+    }
+
+    void place(const std::string& key, size_t hash, const V& value) {
+        size_t mask = _slots.size() - 1;
+        size_t slot = hash & mask;
+        while (_slots[slot].state == USED)
+            slot = (slot + 1) & mask;
+        if (_slots[slot].state == DELETED)
+            --_deleted;
+        _slots[slot].key = key;
+        _slots[slot].hash = hash;
+        _slots[slot].value = value;
+        _slots[slot].state = USED;
+        ++_count;
+    }
+
+public:
+    NameIndex() : _slots(64), _count(0), _deleted(0) {}
+
+    static size_t hash(const StringView& name) { return CaseMapping::hash(name); }
+
+    V find(const StringView& name) const { return find(name, hash(name)); }
+
+    // Hachage déjà calculé (conservé par l'appelant)
+    V find(const StringView& name, size_t hash) const {
+        size_t slot = locate(name, hash);
+        return slot == _slots.size() ? V() : _slots[slot].value;
+    }
+
+    // false si le nom est déjà présent
+    bool insert(const std::string& name, const V& value) {
+        size_t h = hash(StringView(name));
+        if (locate(StringView(name), h) != _slots.size())
+            return false;
+        // Charge maximale 3/4 (entrées supprimées comprises)
+        if ((_count + _deleted + 1) * 4 > _slots.size() * 3)
+            rehash(_count * 4 >= _slots.size() ? _slots.size() * 2 : _slots.size());
+        std::string key;
+        CaseMapping::fold(StringView(name), key);
+        place(key, h, value);
+        return true;
+    }
+
+    bool erase(const StringView& name) { return erase(name, hash(name)); }
+
+    bool erase(const StringView& name, size_t hash) {
+        size_t slot = locate(name, hash);
+        if (slot == _slots.size())
+            return false;
+        _slots[slot].state = DELETED;
+        _slots[slot].key.clear();
+        _slots[slot].value = V();
+        --_count;
+        ++_deleted;
+        return true;
+    }
+
+    size_t size() const { return _count; }
+};
+
+#endif
@@ -0,0 +1,92 @@
+#include "PollEventLoop.hpp"
+
+PollEventLoop::PollEventLoop() {}
+
+PollEventLoop::~PollEventLoop() {}
+
+short PollEventLoop::toPollEvents(unsigned int events) {
+    short pollEvents = 0;
+    if (events & EVENT_READ)
+        pollEvents |= POLLIN;
+    if (events & EVENT_WRITE)
+        pollEvents |= POLLOUT;
+    return pollEvents;
+}
+
+int PollEventLoop::findSlot(int fd) const {
+    if (fd < 0 || (size_t)fd >= _slotByFd.size())
+        return -1;
+    return _slotByFd[fd];
+}
+
+bool PollEventLoop::add(int fd, unsigned int events) {
+    if (fd < 0 || findSlot(fd) != -1)
+        return false;
+
+    if ((size_t)fd >= _slotByFd.size())
+        _slotByFd.resize(fd + 1, -1);
+
+    pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = toPollEvents(events);
+    pfd.revents = 0;
+    _slotByFd[fd] = _pollFds.size();
+    _pollFds.push_back(pfd);
+    return true;
+}
+
+bool PollEventLoop::modify(int fd, unsigned int events) {
+    int slot = findSlot(fd);
+    if (slot == -1)
+        return false;
+
+    _pollFds[slot].events = toPollEvents(events);
+    return true;
+}
+
+void PollEventLoop::remove(int fd) {
+    int slot = findSlot(fd);
+    if (slot == -1)
+        return;
+
+    // Swap-remove : le dernier slot prend la place du slot libéré
+    pollfd last = _pollFds.back();
+    _pollFds[slot] = last;
+    _slotByFd[last.fd] = slot;
+    _pollFds.pop_back();
+    _slotByFd[fd] = -1;
+}
+
+int PollEventLoop::wait(std::vector<IOEvent>& ready, int timeoutMs) {
+    ready.clear();
+    if (_pollFds.empty())
+        return 0;
+
+    int count = poll(&_pollFds[0], _pollFds.size(), timeoutMs);
+    if (count <= 0)
+        return count;
+
+    // Copier les fds prêts : l'appelant peut modifier l'ensemble pendant le dispatch
+    for (size_t i = 0; i < _pollFds.size() && (int)ready.size() < count; ++i) {
+        short revents = _pollFds[i].revents;
+        if (!revents)
+            continue;
+
+        IOEvent event;
+        event.fd = _pollFds[i].fd;
+        event.events = 0;
+        if (revents & POLLIN)
+            event.events |= EVENT_READ;
+        if (revents & POLLOUT)
+            event.events |= EVENT_WRITE;
+        if (revents & (POLLERR | POLLHUP | POLLNVAL))
+            event.events |= EVENT_ERROR;
+        ready.push_back(event);
+    }
+
+    return (int)ready.size();
+}
+
+const char* PollEventLoop::getName() const {
+    return "poll";
+}
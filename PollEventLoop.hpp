@@ -0,0 +1,29 @@
+#ifndef POLLEVENTLOOP_HPP
+#define POLLEVENTLOOP_HPP
+
+#include "EventLoop.hpp"
+#include <poll.h>
+#include <vector>
+
+// Backend de repli portable basé sur poll() (level-triggered)
+// Table de slots dense + index fd -> slot : ajout et retrait en O(1)
+class PollEventLoop : public EventLoop {
+private:
+    std::vector<pollfd> _pollFds;
+    std::vector<int> _slotByFd;     // -1 si le fd n'est pas inscrit
+
+    static short toPollEvents(unsigned int events);
+    int findSlot(int fd) const;
+
+public:
+    PollEventLoop();
+    virtual ~PollEventLoop();
+
+    virtual bool add(int fd, unsigned int events);
+    virtual bool modify(int fd, unsigned int events);
+    virtual void remove(int fd);
+    virtual int wait(std::vector<IOEvent>& ready, int timeoutMs);
+    virtual const char* getName() const;
+};
+
+#endif
@@ -0,0 +1,136 @@
+#include "Reply.hpp"
+#include "Client.hpp"
+
+// Indexée par Reply::Id
+const Reply::Template Reply::TEMPLATES[REPLY_COUNT] = {
+    { "001", ":Welcome to the Internet Relay Network %" },
+    { "002", ":Your host is %, running version %" },
+    { "003", ":This server was created by 42 students" },
+    { "004", "% % % %" },
+    { "005", "CASEMAPPING=% CHANTYPES=#& PREFIX=(o)@ NICKLEN=9 :are supported by this server" },
+    { "219", "% :End of STATS report" },
+    { "221", "%" },
+    { "249", ":%" },
+    { "315", "% :End of WHO list" },
+    { "324", "% %" },
+    { "331", "% :No topic is set" },
+    { "332", "% :%" },
+    { "341", "% %" },
+    { "353", "= % :" },
+    { "366", "% :End of NAMES list" },
+    { "381", ":You are now an IRC operator" },
+    { "401", "% :No such nick/channel" },
+    { "403", "% :No such channel" },
+    { "417", ":Input line was too long" },
+    { "421", "% :Unknown command" },
+    { "431", ":No nickname given" },
+    { "432", "% :Erroneous nickname" },
+    { "433", "% :Nickname is already in use" },
+    { "451", ":You have not registered" },
+    { "461", "% :Not enough parameters" },
+    { "462", ":You may not reregister" },
+    { "464", ":Password incorrect" },
+    { "476", "% :Bad Channel Mask" },
+    { "481", ":Permission Denied- You're not an IRC operator" },
+    { "491", ":No O-lines for your host" }
+};
+
+std::string Reply::_serverName = "ft_irc.42.fr";
+std::string Reply::_version = "ft_irc-1.0";
+std::string Reply::_prefix = ":ft_irc.42.fr ";
+
+void Reply::configure(const std::string& serverName, const std::string& version) {
+    _serverName = serverName;
+    _version = version;
+    _prefix = ":" + serverName + " ";
+}
+
+const std::string& Reply::serverName() {
+    return _serverName;
+}
+
+const std::string& Reply::version() {
+    return _version;
+}
+
+// Taille exacte d'abord (une seule allocation), puis écriture en place
+WireBuffer Reply::render(const Client* client, Id id, const StringView* args, size_t count,
+                         WireBuffer::Kind kind) {
+    const Template& entry = TEMPLATES[id];
+    const std::string& nick = client->getNickname();
+    StringView target = nick.empty() ? StringView("*", 1) : StringView(nick);
+
+    size_t length = _prefix.length() + 4 + target.length + 1;
+    size_t used = 0;
+    for (const char* p = entry.format; *p; ++p) {
+        if (*p == '%' && used < count)
+            length += args[used++].length;
+        else
+            ++length;
+    }
+    if (kind == WireBuffer::LINE)
+        length += 2;
+
+    WireBuffer buffer(length);
+    buffer.append(_prefix.data(), _prefix.length());
+    buffer.append(entry.code, 3);
+    buffer.append(" ", 1);
+    buffer.append(target.data, target.length);
+    buffer.append(" ", 1);
+
+    used = 0;
+    const char* run = entry.format;
+    const char* p = entry.format;
+    for (; *p; ++p) {
+        if (*p != '%' || used >= count)
+            continue;
+        buffer.append(run, p - run);
+        buffer.append(args[used].data, args[used].length);
+        ++used;
+        run = p + 1;
+    }
+    buffer.append(run, p - run);
+
+    if (kind == WireBuffer::LINE)
+        buffer.append("\r\n", 2);
+    return buffer;
+}
+
+void Reply::send(Client* client, Id id) {
+    client->sendBuffer(render(client, id, NULL, 0, WireBuffer::LINE));
+}
+
+void Reply::send(Client* client, Id id, const StringView& a) {
+    client->sendBuffer(render(client, id, &a, 1, WireBuffer::LINE));
+}
+
+void Reply::send(Client* client, Id id, const StringView& a, const StringView& b) {
+    StringView args[2] = { a, b };
+    client->sendBuffer(render(client, id, args, 2, WireBuffer::LINE));
+}
+
+void Reply::send(Client* client, Id id, const StringView& a, const StringView& b,
+                 const StringView& c) {
+    StringView args[3] = { a, b, c };
+    client->sendBuffer(render(client, id, args, 3, WireBuffer::LINE));
+}
+
+void Reply::send(Client* client, Id id, const StringView& a, const StringView& b,
+                 const StringView& c, const StringView& d) {
+    StringView args[4] = { a, b, c, d };
+    client->sendBuffer(render(client, id, args, 4, WireBuffer::LINE));
+}
+
+WireBuffer Reply::header(const Client* client, Id id, const StringView& a) {
+    return render(client, id, &a, 1, WireBuffer::FRAGMENT);
+}
+
+// Longueur d'une ligne sans CRLF pour un pseudo et des arguments de taille donnée
+size_t Reply::headerLength(Id id, size_t nickLength, size_t argsLength) {
+    size_t length = _prefix.length() + 4 + nickLength + 1 + argsLength;
+    for (const char* p = TEMPLATES[id].format; *p; ++p) {
+        if (*p != '%')
+            ++length;
+    }
+    return length;
+}
@@ -0,0 +1,83 @@
+#ifndef REPLY_HPP
+#define REPLY_HPP
+
+#include "StringView.hpp"
+#include "WireBuffer.hpp"
+#include <string>
+
+class Client;
+
+// Réponses numériques : table de gabarits fixée à la compilation
+// Ligne produite : ":<serveur> <code> <pseudo|*> " + gabarit, chaque '%' étant
+// remplacé par l'argument suivant. La taille est calculée d'avance et la ligne
+// écrite directement dans le WireBuffer mis en file, sans chaîne temporaire.
+class Reply {
+public:
+    // Ordre identique à la table TEMPLATES
+    enum Id {
+        RPL_WELCOME,            // 001
+        RPL_YOURHOST,           // 002
+        RPL_CREATED,            // 003
+        RPL_MYINFO,             // 004
+        RPL_ISUPPORT,           // 005
+        RPL_ENDOFSTATS,         // 219
+        RPL_UMODEIS,            // 221
+        RPL_STATSDEBUG,         // 249
+        RPL_ENDOFWHO,           // 315
+        RPL_CHANNELMODEIS,      // 324
+        RPL_NOTOPIC,            // 331
+        RPL_TOPIC,              // 332
+        RPL_INVITING,           // 341
+        RPL_NAMREPLY,           // 353 (en-tête, corps en cache dans Channel)
+        RPL_ENDOFNAMES,         // 366
+        RPL_YOUREOPER,          // 381
+        ERR_NOSUCHNICK,         // 401
+        ERR_NOSUCHCHANNEL,      // 403
+        ERR_INPUTTOOLONG,       // 417
+        ERR_UNKNOWNCOMMAND,     // 421
+        ERR_NONICKNAMEGIVEN,    // 431
+        ERR_ERRONEUSNICKNAME,   // 432
+        ERR_NICKNAMEINUSE,      // 433
+        ERR_NOTREGISTERED,      // 451
+        ERR_NEEDMOREPARAMS,     // 461
+        ERR_ALREADYREGISTERED,  // 462
+        ERR_PASSWDMISMATCH,     // 464
+        ERR_BADCHANMASK,        // 476
+        ERR_NOPRIVILEGES,       // 481
+        ERR_NOOPERHOST,         // 491
+        REPLY_COUNT
+    };
+
+private:
+    struct Template {
+        const char *code;       // Trois chiffres, zéros compris
+        const char *format;
+    };
+    static const Template TEMPLATES[REPLY_COUNT];
+
+    static std::string _serverName;
+    static std::string _version;
+    static std::string _prefix;     // ":<serveur> " pré-rendu
+
+    static WireBuffer render(const Client* client, Id id, const StringView* args, size_t count,
+                             WireBuffer::Kind kind);
+
+public:
+    static void configure(const std::string& serverName, const std::string& version);
+    static const std::string& serverName();
+    static const std::string& version();
+
+    static void send(Client* client, Id id);
+    static void send(Client* client, Id id, const StringView& a);
+    static void send(Client* client, Id id, const StringView& a, const StringView& b);
+    static void send(Client* client, Id id, const StringView& a, const StringView& b,
+                     const StringView& c);
+    static void send(Client* client, Id id, const StringView& a, const StringView& b,
+                     const StringView& c, const StringView& d);
+
+    // Début de ligne sans CRLF, complété par un corps partagé (353)
+    static WireBuffer header(const Client* client, Id id, const StringView& a);
+    static size_t headerLength(Id id, size_t nickLength, size_t argsLength);
+};
+
+#endif
@@ -1,4 +1,7 @@
 #include "Server.hpp"
+#include "CaseMapping.hpp"
+#include "Reply.hpp"
+#include "Clock.hpp"
 #include "ChannelManager.hpp"
 #include <iostream>
 #include <cstring>
@@ -7,8 +10,13 @@
 #include <stdexcept>
 #include <cerrno>
 
-Server::Server(int port, const std::string& password) 
-    : _port(port), _password(password), _serverSocket(-1) {
+Server::Server(int port, const std::string& password, const ServerConfig& config) 
+    : _port(port), _password(password), _listener(NULL), _config(config), _eventLoop(NULL) {
+    Clock::update();
+    if (!CaseMapping::select(_config.caseMapping))
+        throw std::runtime_error("Unknown casemapping: " + _config.caseMapping);
+    Reply::configure(_config.serverName, _config.serverVersion);
+    _eventLoop = EventLoop::create(_config.eventBackend);
     _clientManager = new ClientManager(this, password);
     _channelManager = new ChannelManager(this);
     
@@ -17,61 +25,41 @@ Server::Server(int port, const std::string& password)
 }
 
 Server::~Server() {
-    if (_serverSocket != -1)
-        close(_serverSocket);
+    delete _listener;
     
-    // Fermer tous les fds de poll
-    for (size_t i = 1; i < _pollFds.size(); ++i) {
-        close(_pollFds[i].fd);
+    // Fermer tous les fds clients
+    const std::map<int, Client*>& clients = _clientManager->getClients();
+    for (std::map<int, Client*>::const_iterator it = clients.begin(); it != clients.end(); ++it) {
+        close(it->first);
     }
     
     delete _clientManager;
     delete _channelManager;
+    delete _eventLoop;
 }
 
 void Server::setupSocket() {
-    _serverSocket = socket(AF_INET, SOCK_STREAM, 0);
-    if (_serverSocket == -1)
-        throw std::runtime_error("Socket creation failed");
-    
-    // Non-blocking
-    fcntl(_serverSocket, F_SETFL, O_NONBLOCK);
-    
-    // Réutiliser l'adresse
-    int opt = 1;
-    setsockopt(_serverSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    _listener = new Listener(_port, _config.listenBacklog, _config.acceptPerTick);
     
-    // Configuration de l'adresse
-    sockaddr_in addr;
-    std::memset(&addr, 0, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(_port);
-    addr.sin_addr.s_addr = INADDR_ANY;
-    
-    if (bind(_serverSocket, (sockaddr*)&addr, sizeof(addr)) < 0)
-        throw std::runtime_error("Bind failed");
-    
-    if (listen(_serverSocket, SOMAXCONN) < 0)
-        throw std::runtime_error("Listen failed");
-    
-    // Ajouter le serveur socket au poll
-    pollfd serverPfd;
-    serverPfd.fd = _serverSocket;
-    serverPfd.events = POLLIN;
-    serverPfd.revents = 0;
-    _pollFds.push_back(serverPfd);
+    // Inscrire le socket serveur auprès du backend d'événements
+    if (!_eventLoop->add(_listener->getFd(), EVENT_READ))
+        throw std::runtime_error("Event backend registration failed");
 }
 
 void Server::start() {
     setupSocket();
-    std::cout << GREEN << "Server started on port " << _port << RESET << std::endl;
+    std::cout << GREEN << "Server started on port " << _port
+              << " (" << _eventLoop->getName() << ")" << RESET << std::endl;
 }
 
 void Server::run() {
     while (true) {
-        int pollCount = poll(&_pollFds[0], _pollFds.size(), 1000); // Timeout 1s
+        // File d'accept non vidée (plafond par tick) ou commandes en attente : ne pas attendre
+        bool busy = _listener->needsImmediateRetry() || _clientManager->hasPendingCommands();
+        int timeout = busy ? 0 : 1000;
+        int eventCount = _eventLoop->wait(_readyEvents, timeout); // Timeout 1s
         
-        if (pollCount < 0) {
+        if (eventCount < 0) {
             if (errno == EINTR) {
                 // Signal reçu, arrêter proprement
                 std::cout << YELLOW << "Signal received, shutting down..." << RESET << std::endl;
@@ -81,24 +69,43 @@ void Server::run() {
             break;
         }
         
-        // Vérifier les événements
-        for (size_t i = 0; i < _pollFds.size(); ++i) {
-            if (_pollFds[i].revents & POLLIN) {
-                if (_pollFds[i].fd == _serverSocket) {
-                    acceptNewClient();
-                } else {
-                    handleClientData(i);
-                }
+        // Une seule lecture d'horloge par tick
+        Clock::update();
+        
+        // Reprendre l'acceptation reportée au tick précédent
+        if (_listener->hasBacklog())
+            acceptNewClient();
+        
+        // Traiter uniquement les fds prêts
+        for (size_t i = 0; i < _readyEvents.size(); ++i) {
+            const IOEvent& event = _readyEvents[i];
+            if (event.fd == _listener->getFd()) {
+                acceptNewClient();
+                continue;
             }
+            if (event.events & EVENT_WRITE)
+                _clientManager->handleClientWritable(event.fd);
+            if (event.events & (EVENT_READ | EVENT_ERROR))
+                handleClientData(event.fd);
         }
         
+        // Commandes reçues : budget par client, tourniquet entre clients
+        _clientManager->runCommandQueue();
+        
+        // Minuteurs échus : inscription, PING sur inactivité, PONG manquant
+        _clientManager->runTimers();
+        
+        // Compacter les connexions fermées pendant ce tick
+        _clientManager->reapClients();
+        
+        // Envoyer la sortie accumulée pendant le tick (un appel par client)
+        _clientManager->flushPendingOutput();
+        
         // Maintenance périodique
-        static time_t lastMaintenance = time(NULL);
-        if (time(NULL) - lastMaintenance > 30) {
-            _clientManager->checkTimeouts();
+        static time_t lastMaintenance = Clock::wallTime();
+        if (Clock::wallTime() - lastMaintenance > 30) {
             _channelManager->cleanupEmptyChannels();
-            cleanupDisconnectedClients();
-            lastMaintenance = time(NULL);
+            lastMaintenance = Clock::wallTime();
         }
     }
     
@@ -106,88 +113,101 @@ void Server::run() {
 }
 
 void Server::acceptNewClient() {
-    sockaddr_in clientAddr;
-    socklen_t len = sizeof(clientAddr);
-    int clientSocket = accept(_serverSocket, (sockaddr*)&clientAddr, &len);
-    
-    if (clientSocket < 0)
-        return;
+    // Edge-triggered : vider la file du listen par lots (plafond par tick)
+    _accepted.clear();
+    _listener->acceptBatch(_accepted);
     
-    fcntl(clientSocket, F_SETFL, O_NONBLOCK);
-    
-    // Ajouter au poll
-    pollfd clientPfd;
-    clientPfd.fd = clientSocket;
-    clientPfd.events = POLLIN;
-    clientPfd.revents = 0;
-    _pollFds.push_back(clientPfd);
-    
-    // Ajouter au gestionnaire de clients
-    _clientManager->addClient(clientSocket);
-    
-    std::cout << GREEN << "New client connected (fd " << clientSocket << ")" << RESET << std::endl;
-}
-
-void Server::handleClientData(size_t i) {
-    char buffer[1024];
-    int clientSocket = _pollFds[i].fd;
-    int bytesRead = recv(clientSocket, buffer, sizeof(buffer) - 1, 0);
-    
-    if (bytesRead <= 0) {
-        removeClient(i);
-        return;
+    for (size_t i = 0; i < _accepted.size(); ++i) {
+        int clientSocket = _accepted[i].fd;
+        
+        // Inscrire auprès du backend d'événements
+        if (!_eventLoop->add(clientSocket, EVENT_READ)) {
+            close(clientSocket);
+            continue;
+        }
+        
+        // Ajouter au gestionnaire de clients (après contrôle d'admission)
+        if (!_clientManager->addClient(clientSocket, _accepted[i].addr))
+            continue;
+        
+        std::cout << GREEN << "New client connected (fd " << clientSocket << ")" << RESET << std::endl;
     }
-    
-    buffer[bytesRead] = '\0';
-    
-    // Traiter les données via le ClientManager
-    _clientManager->handleClientData(clientSocket, std::string(buffer));
 }
 
-void Server::removeClient(size_t i) {
-    int clientSocket = _pollFds[i].fd;
-    
-    // Supprimer du gestionnaire de clients (qui gère les canaux aussi)
-    Client* client = _clientManager->getClient(clientSocket);
-    if (client) {
-        _channelManager->removeClientFromAllChannels(client);
-        _clientManager->removeClient(clientSocket);
-    }
+void Server::handleClientData(int fd) {
+    static const size_t READ_CHUNK = 4096;
+    static const size_t READ_PER_TICK = 16 * 1024;  // Un pair rapide ne doit jamais atteindre EAGAIN
     
-    // Supprimer du poll
-    _pollFds.erase(_pollFds.begin() + i);
+    Client* client = _clientManager->getClient(fd);
+    if (!client || client->isClosing())
+        return;
     
-    std::cout << YELLOW << "Client disconnected (fd " << clientSocket << ")" << RESET << std::endl;
-}
-
-void Server::cleanupDisconnectedClients() {
-    // Nettoyer les clients déconnectés qui ne sont plus dans les pollFds
-    std::vector<int> validFds;
-    for (size_t i = 1; i < _pollFds.size(); ++i) {
-        validFds.push_back(_pollFds[i].fd);
+    // Lignes encore en attente d'un tick précédent : laisser les octets dans le
+    // noyau (contrôle de flux TCP) jusqu'à ce que l'ordonnanceur ait rattrapé
+    if (client->isRunQueued()) {
+        client->setReadDeferred(true);
+        return;
     }
     
-    // Vérifier les clients du ClientManager
-    const std::map<int, Client*>& clients = _clientManager->getClients();
-    std::vector<int> toRemove;
-    
-    for (std::map<int, Client*>::const_iterator it = clients.begin(); it != clients.end(); ++it) {
-        bool found = false;
-        for (size_t j = 0; j < validFds.size(); ++j) {
-            if (validFds[j] == it->first) {
-                found = true;
-                break;
-            }
+    // Edge-triggered : lire jusqu'à EAGAIN (ou jusqu'au plafond du tick),
+    // directement dans le buffer du client
+    InputBuffer& input = client->getInputBuffer();
+    size_t total = 0;
+    while (true) {
+        if (total >= READ_PER_TICK) {
+            // Reste à lire : l'ordonnanceur reprendra la lecture une fois les lignes traitées
+            client->setReadDeferred(true);
+            _clientManager->scheduleCommands(client);
+            return;
         }
-        if (!found) {
-            toRemove.push_back(it->first);
+        
+        char* space = input.prepare(READ_CHUNK);
+        ssize_t bytesRead = recv(fd, space, input.writable(), 0);
+        
+        if (bytesRead < 0 && errno == EINTR)
+            continue;
+        if (bytesRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return;
+        if (bytesRead <= 0) {
+            removeClient(fd);
+            return;
         }
+        input.commit(bytesRead);
+        total += bytesRead;
+        if (!_clientManager->checkRecvQueue(client))
+            return;
+        
+        // Lignes complètes traitées en fin de tick par l'ordonnanceur
+        _clientManager->scheduleCommands(client);
     }
+}
+
+void Server::removeClient(int fd) {
+    // Suppression différée : le ClientManager gère les canaux, la désinscription
+    // et la fermeture du fd lors du compactage de fin de tick
+    _clientManager->scheduleRemoval(fd);
     
-    // Supprimer les clients orphelins
-    for (size_t i = 0; i < toRemove.size(); ++i) {
-        _clientManager->removeClient(toRemove[i]);
-    }
+    std::cout << YELLOW << "Client disconnected (fd " << fd << ")" << RESET << std::endl;
+}
+
+void Server::unregisterClient(int fd) {
+    _eventLoop->remove(fd);
+}
+
+void Server::resumeRead(int fd) {
+    handleClientData(fd);
+}
+
+void Server::setWriteInterest(int fd, bool enabled) {
+    _eventLoop->modify(fd, enabled ? (EVENT_READ | EVENT_WRITE) : EVENT_READ);
+}
+
+AcceptStats Server::getAcceptStats() const {
+    return _listener->getStats();
+}
+
+long Server::getAcceptQueueDepth() const {
+    return _listener->getQueueDepth();
 }
 
 // Getters
@@ -199,6 +219,10 @@ ChannelManager* Server::getChannelManager() const {
     return _channelManager;
 }
 
+const ServerConfig& Server::getConfig() const {
+    return _config;
+}
+
 // Utilitaires
 void Server::broadcast(const std::string& message) {
     _clientManager->broadcastToAll(message);
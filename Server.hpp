@@ -3,7 +3,9 @@
 
 #include "ClientManager.hpp"
 #include "ChannelManager.hpp"
-#include <poll.h>
+#include "EventLoop.hpp"
+#include "ServerConfig.hpp"
+#include "Listener.hpp"
 #include <vector>
 #include <netinet/in.h>
 
@@ -18,8 +20,11 @@ class Server {
 private:
     int _port;
     std::string _password;
-    int _serverSocket;
-    std::vector<pollfd> _pollFds;
+    Listener *_listener;
+    std::vector<AcceptedConnection> _accepted;
+    ServerConfig _config;
+    EventLoop *_eventLoop;
+    std::vector<IOEvent> _readyEvents;
     
     // Gestionnaires (architecture d'Amir)
     ClientManager *_clientManager;
@@ -28,12 +33,11 @@ private:
     // Méthodes privées
     void setupSocket();
     void acceptNewClient();
-    void handleClientData(size_t i);
-    void removeClient(size_t i);
-    void cleanupDisconnectedClients();
+    void handleClientData(int fd);
+    void removeClient(int fd);
 
 public:
-    Server(int port, const std::string& password);
+    Server(int port, const std::string& password, const ServerConfig& config = ServerConfig());
     ~Server();
     
     void start();
@@ -42,6 +46,16 @@ public:
     // Getters pour les gestionnaires
     ClientManager* getClientManager() const;
     ChannelManager* getChannelManager() const;
+    const ServerConfig& getConfig() const;
+    
+    // Désinscription d'un fd client du backend d'événements (avant close)
+    void unregisterClient(int fd);
+    void setWriteInterest(int fd, bool enabled);
+    void resumeRead(int fd);    // Lecture reportée par l'ordonnanceur de commandes
+    
+    // Statistiques d'acceptation
+    AcceptStats getAcceptStats() const;
+    long getAcceptQueueDepth() const;
     
     // Utilitaires
     void broadcast(const std::string& message);
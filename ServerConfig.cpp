@@ -0,0 +1,95 @@
+#include "ServerConfig.hpp"
+#include <cstdlib>
+
+ServerConfig::ServerConfig()
+    : serverName("ft_irc.42.fr"),
+      serverVersion("ft_irc-1.0"),
+      eventBackend(""),
+      listenBacklog(0),
+      acceptPerTick(256),
+      commandsPerTick(32),
+      maxPerIp(10),
+      maxPerCidr(40),
+      cidrPrefix(24),
+      connectRate(20),
+      connectWindow(60),
+      maxUnregistered(1024),
+      floodRate(0),
+      floodBurst(10),
+      floodExcess(8192),
+      caseMapping("rfc1459"),
+      operName("admin"),
+      operPassword(""),
+      sendqHighWater(256 * 1024),
+      sendqMaxBytes(1024 * 1024),
+      sendqMaxMessages(8192),
+      flushThreshold(32 * 1024),
+      recvqMaxBytes(64 * 1024),
+      registrationTimeout(30),
+      pingInterval(120),
+      pingTimeout(60) {}
+
+// Lire une variable d'environnement texte
+static void readString(const char* name, std::string& value) {
+    const char* env = std::getenv(name);
+    if (env && *env)
+        value = env;
+}
+
+// Lire une variable d'environnement numérique (ignorée si invalide)
+static void readSize(const char* name, size_t& value) {
+    const char* env = std::getenv(name);
+    if (!env || !*env)
+        return;
+    char* end = NULL;
+    unsigned long parsed = std::strtoul(env, &end, 10);
+    if (*end == '\0')
+        value = parsed;
+}
+
+// Nom de serveur : un seul jeton d'au plus MAX_SERVER_NAME caractères
+// (il préfixe chaque réponse et entre dans le calcul des morceaux de NAMES)
+static bool isValidServerName(const std::string& name) {
+    if (name.empty() || name.length() > ServerConfig::MAX_SERVER_NAME)
+        return false;
+    for (size_t i = 0; i < name.length(); ++i) {
+        unsigned char c = name[i];
+        if (c <= 32 || c == ':')
+            return false;
+    }
+    return true;
+}
+
+void ServerConfig::loadFromEnvironment() {
+    std::string name;
+    readString("FTIRC_SERVER_NAME", name);
+    if (isValidServerName(name))
+        serverName = name;
+    readString("FTIRC_SERVER_VERSION", serverVersion);
+    readString("FTIRC_EVENT_BACKEND", eventBackend);
+    size_t backlog = listenBacklog;
+    readSize("FTIRC_LISTEN_BACKLOG", backlog);
+    listenBacklog = (int)backlog;
+    readSize("FTIRC_ACCEPT_PER_TICK", acceptPerTick);
+    readSize("FTIRC_COMMANDS_PER_TICK", commandsPerTick);
+    readSize("FTIRC_MAX_PER_IP", maxPerIp);
+    readSize("FTIRC_MAX_PER_CIDR", maxPerCidr);
+    readSize("FTIRC_CIDR_PREFIX", cidrPrefix);
+    readSize("FTIRC_CONNECT_RATE", connectRate);
+    readSize("FTIRC_CONNECT_WINDOW", connectWindow);
+    readSize("FTIRC_MAX_UNREGISTERED", maxUnregistered);
+    readSize("FTIRC_FLOOD_RATE", floodRate);
+    readSize("FTIRC_FLOOD_BURST", floodBurst);
+    readSize("FTIRC_FLOOD_EXCESS", floodExcess);
+    readString("FTIRC_CASEMAPPING", caseMapping);
+    readString("FTIRC_OPER_NAME", operName);
+    readString("FTIRC_OPER_PASSWORD", operPassword);
+    readSize("FTIRC_SENDQ_HIGHWATER", sendqHighWater);
+    readSize("FTIRC_SENDQ_MAX", sendqMaxBytes);
+    readSize("FTIRC_SENDQ_MAX_MESSAGES", sendqMaxMessages);
+    readSize("FTIRC_FLUSH_THRESHOLD", flushThreshold);
+    readSize("FTIRC_RECVQ_MAX", recvqMaxBytes);
+    readSize("FTIRC_REGISTRATION_TIMEOUT", registrationTimeout);
+    readSize("FTIRC_PING_INTERVAL", pingInterval);
+    readSize("FTIRC_PING_TIMEOUT", pingTimeout);
+}
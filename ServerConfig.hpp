@@ -0,0 +1,53 @@
+#ifndef SERVERCONFIG_HPP
+#define SERVERCONFIG_HPP
+
+#include <string>
+
+// Réglages du serveur, surchargeables par variables d'environnement FTIRC_*
+// (la ligne de commande reste limitée à <port> <password>)
+struct ServerConfig {
+    static const size_t MAX_SERVER_NAME = 63;   // RFC 2812 (nom d'hôte)
+
+    std::string serverName;     // FTIRC_SERVER_NAME : préfixe des réponses du serveur (ignoré si invalide)
+    std::string serverVersion;  // FTIRC_SERVER_VERSION : annoncée dans 002/004
+    std::string eventBackend;   // FTIRC_EVENT_BACKEND : "epoll" ou "poll"
+    int listenBacklog;          // FTIRC_LISTEN_BACKLOG : file du listen (0 = SOMAXCONN)
+    size_t acceptPerTick;       // FTIRC_ACCEPT_PER_TICK : connexions acceptées par tick (0 = illimité)
+    size_t commandsPerTick;     // FTIRC_COMMANDS_PER_TICK : lignes traitées par client et par tick (0 = illimité)
+
+    // Admission des connexions par adresse source (0 = pas de limite)
+    size_t maxPerIp;            // FTIRC_MAX_PER_IP : connexions ouvertes par IP
+    size_t maxPerCidr;          // FTIRC_MAX_PER_CIDR : connexions ouvertes par réseau
+    size_t cidrPrefix;          // FTIRC_CIDR_PREFIX : longueur du préfixe de réseau (bits)
+    size_t connectRate;         // FTIRC_CONNECT_RATE : tentatives par IP et par fenêtre
+    size_t connectWindow;       // FTIRC_CONNECT_WINDOW : fenêtre glissante (secondes)
+    size_t maxUnregistered;     // FTIRC_MAX_UNREGISTERED : clients non inscrits, tous confondus
+
+    // Contrôle de flood par seau de jetons (coûts dans la table des commandes)
+    size_t floodRate;           // FTIRC_FLOOD_RATE : jetons regagnés par seconde (0 = désactivé)
+    size_t floodBurst;          // FTIRC_FLOOD_BURST : capacité du seau
+    size_t floodExcess;         // FTIRC_FLOOD_EXCESS : octets en attente sous fakelag avant déconnexion
+    std::string caseMapping;    // FTIRC_CASEMAPPING : "rfc1459", "strict-rfc1459" ou "ascii"
+
+    // Opérateur IRC (OPER désactivé si le mot de passe est vide)
+    std::string operName;       // FTIRC_OPER_NAME
+    std::string operPassword;   // FTIRC_OPER_PASSWORD
+
+    // Limites de file d'envoi par client
+    size_t sendqHighWater;      // FTIRC_SENDQ_HIGHWATER : seuil d'alerte (octets)
+    size_t sendqMaxBytes;       // FTIRC_SENDQ_MAX : limite dure (octets)
+    size_t sendqMaxMessages;    // FTIRC_SENDQ_MAX_MESSAGES : limite dure (lignes)
+    size_t flushThreshold;      // FTIRC_FLUSH_THRESHOLD : envoi anticipé dans le tick (octets)
+    size_t recvqMaxBytes;       // FTIRC_RECVQ_MAX : octets reçus non traités, déconnexion au-delà
+
+    // Vivacité des connexions (secondes)
+    size_t registrationTimeout; // FTIRC_REGISTRATION_TIMEOUT : délai pour PASS/NICK/USER
+    size_t pingInterval;        // FTIRC_PING_INTERVAL : inactivité avant PING
+    size_t pingTimeout;         // FTIRC_PING_TIMEOUT : attente du PONG avant déconnexion
+
+    ServerConfig();
+
+    void loadFromEnvironment();
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef STRINGVIEW_HPP
+#define STRINGVIEW_HPP
+
+#include <string>
+#include <cstddef>
+#include <cstring>
+
+// Tranche non propriétaire d'octets (ligne du buffer de réception, paramètre…)
+// Valide tant que le buffer source n'est ni modifié ni compacté.
+struct StringView {
+    const char *data;
+    size_t length;
+
+    StringView() : data(NULL), length(0) {}
+    StringView(const char *d, size_t len) : data(d), length(len) {}
+    StringView(const std::string& str) : data(str.data()), length(str.length()) {}
+
+    bool empty() const { return length == 0; }
+    char operator[](size_t i) const { return data[i]; }
+    std::string str() const { return std::string(data, length); }
+
+    bool operator==(const char *literal) const {
+        size_t len = std::strlen(literal);
+        return len == length && std::memcmp(data, literal, len) == 0;
+    }
+    bool operator==(const std::string& other) const {
+        return other.length() == length && std::memcmp(data, other.data(), length) == 0;
+    }
+    bool operator!=(const std::string& other) const { return !(*this == other); }
+};
+
+#endif
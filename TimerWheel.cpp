@@ -0,0 +1,118 @@
+#include "TimerWheel.hpp"
+
+TimerWheel::TimerWheel(unsigned long resolutionMs, unsigned long nowMs)
+    : _resolutionMs(resolutionMs ? resolutionMs : 1), _base(nowMs / _resolutionMs) {
+    for (unsigned int level = 0; level < LEVELS; ++level) {
+        for (unsigned int slot = 0; slot < SLOTS; ++slot)
+            initList(_slots[level][slot]);
+    }
+    initList(_expired);
+}
+
+// Détacher les minuteurs encore armés (leurs propriétaires peuvent survivre à la roue)
+TimerWheel::~TimerWheel() {
+    for (unsigned int level = 0; level < LEVELS; ++level) {
+        for (unsigned int slot = 0; slot < SLOTS; ++slot) {
+            Timer& head = _slots[level][slot];
+            while (head.next != &head)
+                head.next->cancel();
+            head.prev = head.next = NULL;
+        }
+    }
+    while (_expired.next != &_expired)
+        _expired.next->cancel();
+    _expired.prev = _expired.next = NULL;
+}
+
+void TimerWheel::initList(Timer& head) {
+    head.prev = &head;
+    head.next = &head;
+}
+
+void TimerWheel::pushBack(Timer& head, Timer* timer) {
+    timer->prev = head.prev;
+    timer->next = &head;
+    head.prev->next = timer;
+    head.prev = timer;
+}
+
+// Choisir le niveau selon la distance à l'échéance
+void TimerWheel::place(Timer* timer) {
+    unsigned long expires = timer->expires;
+    unsigned long delta = expires - _base;
+
+    if ((long)delta < 0) {
+        // Déjà échu : traité au prochain tick
+        pushBack(_slots[0][_base & SLOT_MASK], timer);
+        return;
+    }
+    if (delta > MAX_DELTA) {
+        expires = _base + MAX_DELTA;
+        delta = MAX_DELTA;
+    }
+
+    unsigned int level = 0;
+    while (level + 1 < LEVELS && delta >= (1UL << ((level + 1) * SLOT_BITS)))
+        ++level;
+    pushBack(_slots[level][(expires >> (level * SLOT_BITS)) & SLOT_MASK], timer);
+}
+
+// Redistribuer une case d'un niveau supérieur vers les niveaux inférieurs
+unsigned long TimerWheel::cascade(unsigned int level, unsigned long index) {
+    Timer& head = _slots[level][index];
+    Timer list;
+    if (head.next != &head) {
+        list.next = head.next;
+        list.prev = head.prev;
+        list.next->prev = &list;
+        list.prev->next = &list;
+        initList(head);
+
+        while (list.next != &list) {
+            Timer* timer = list.next;
+            timer->cancel();
+            place(timer);
+        }
+    }
+    list.prev = list.next = NULL;
+    return index;
+}
+
+void TimerWheel::schedule(Timer* timer, unsigned long whenMs) {
+    timer->cancel();
+    // Arrondi au tick supérieur : jamais d'expiration anticipée
+    timer->expires = (whenMs + _resolutionMs - 1) / _resolutionMs;
+    place(timer);
+}
+
+void TimerWheel::advance(unsigned long nowMs) {
+    unsigned long target = nowMs / _resolutionMs;
+
+    while ((long)(target - _base) >= 0) {
+        unsigned long index = _base & SLOT_MASK;
+
+        // Le niveau 0 a fait un tour : descendre la case suivante du niveau 1, etc.
+        if (index == 0) {
+            for (unsigned int level = 1; level < LEVELS; ++level) {
+                if (cascade(level, (_base >> (level * SLOT_BITS)) & SLOT_MASK) != 0)
+                    break;
+            }
+        }
+        ++_base;
+
+        Timer& head = _slots[0][index];
+        while (head.next != &head) {
+            Timer* timer = head.next;
+            timer->cancel();
+            pushBack(_expired, timer);
+        }
+    }
+}
+
+Timer* TimerWheel::popExpired() {
+    if (_expired.next == &_expired)
+        return NULL;
+    Timer* timer = _expired.next;
+    timer->cancel();
+    return timer;
+}
@@ -0,0 +1,65 @@
+#ifndef TIMERWHEEL_HPP
+#define TIMERWHEEL_HPP
+
+#include <cstddef>
+
+// Minuteur intrusif (embarqué dans son propriétaire, aucune allocation)
+// Maillon d'une liste doublement chaînée : armement et annulation en O(1).
+struct Timer {
+    Timer *prev;
+    Timer *next;
+    unsigned long expires;      // En ticks de la roue
+    void *owner;
+
+    Timer() : prev(NULL), next(NULL), expires(0), owner(NULL) {}
+    ~Timer() { cancel(); }
+
+    bool isPending() const { return next != NULL; }
+
+    void cancel() {
+        if (!next)
+            return;
+        prev->next = next;
+        next->prev = prev;
+        prev = next = NULL;
+    }
+};
+
+// Roue de minuteurs hiérarchique (4 niveaux de 64 cases)
+// Le niveau 0 couvre 64 ticks ; un niveau supérieur est redistribué vers le
+// bas quand l'index du niveau inférieur repasse à 0. Avancer la roue ne coûte
+// que le nombre de ticks écoulés plus les minuteurs échus, jamais O(clients).
+class TimerWheel {
+private:
+    static const unsigned int LEVELS = 4;
+    static const unsigned int SLOT_BITS = 6;
+    static const unsigned int SLOTS = 1 << SLOT_BITS;
+    static const unsigned long SLOT_MASK = SLOTS - 1;
+    static const unsigned long MAX_DELTA = (1UL << (LEVELS * SLOT_BITS)) - 1;
+
+    Timer _slots[LEVELS][SLOTS];    // Têtes de liste sentinelles
+    Timer _expired;                 // Échus, en attente de popExpired
+    unsigned long _resolutionMs;
+    unsigned long _base;            // Prochain tick à traiter
+
+    TimerWheel(const TimerWheel&);
+    TimerWheel& operator=(const TimerWheel&);
+
+    static void initList(Timer& head);
+    static void pushBack(Timer& head, Timer* timer);
+    void place(Timer* timer);
+    unsigned long cascade(unsigned int level, unsigned long index);
+
+public:
+    TimerWheel(unsigned long resolutionMs, unsigned long nowMs);
+    ~TimerWheel();
+
+    // Armer (ou réarmer) pour une échéance absolue en millisecondes
+    void schedule(Timer* timer, unsigned long whenMs);
+
+    // Faire avancer la roue jusqu'à nowMs ; les minuteurs échus passent dans la file
+    void advance(unsigned long nowMs);
+    Timer* popExpired();    // NULL quand la file est vide
+};
+
+#endif
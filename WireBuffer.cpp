@@ -0,0 +1,58 @@
+#include "WireBuffer.hpp"
+
+WireBuffer::WireBuffer() : _data(NULL) {}
+
+WireBuffer::WireBuffer(const std::string& line, Kind kind) : _data(new Data) {
+    _data->refCount = 1;
+    _data->bytes.reserve(line.length() + 2);
+    _data->bytes = line;
+    if (kind == LINE)
+        _data->bytes += "\r\n";
+}
+
+WireBuffer::WireBuffer(size_t capacity) : _data(new Data) {
+    _data->refCount = 1;
+    _data->bytes.reserve(capacity);
+}
+
+WireBuffer::WireBuffer(const WireBuffer& other) : _data(other._data) {
+    if (_data)
+        ++_data->refCount;
+}
+
+WireBuffer& WireBuffer::operator=(const WireBuffer& other) {
+    if (_data != other._data) {
+        release();
+        _data = other._data;
+        if (_data)
+            ++_data->refCount;
+    }
+    return *this;
+}
+
+WireBuffer::~WireBuffer() {
+    release();
+}
+
+void WireBuffer::release() {
+    if (_data && --_data->refCount == 0)
+        delete _data;
+    _data = NULL;
+}
+
+const char* WireBuffer::data() const {
+    return _data ? _data->bytes.data() : "";
+}
+
+size_t WireBuffer::length() const {
+    return _data ? _data->bytes.length() : 0;
+}
+
+bool WireBuffer::empty() const {
+    return length() == 0;
+}
+
+void WireBuffer::append(const char* bytes, size_t length) {
+    if (_data && _data->refCount == 1)
+        _data->bytes.append(bytes, length);
+}
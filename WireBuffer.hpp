@@ -0,0 +1,40 @@
+#ifndef WIREBUFFER_HPP
+#define WIREBUFFER_HPP
+
+#include <string>
+
+// Ligne IRC sérialisée une seule fois (CRLF inclus), immuable et partagée
+// par compteur de références entre les files d'envoi des destinataires.
+class WireBuffer {
+public:
+    enum Kind {
+        LINE,       // Ligne complète : CRLF ajouté
+        FRAGMENT    // Début de ligne (en-tête propre au destinataire), sans CRLF
+    };
+
+private:
+    struct Data {
+        int refCount;
+        std::string bytes;
+    };
+    Data *_data;
+
+    void release();
+
+public:
+    WireBuffer();
+    explicit WireBuffer(const std::string& line, Kind kind = LINE);
+    explicit WireBuffer(size_t capacity);   // Vide, rempli par append avant tout partage
+    WireBuffer(const WireBuffer& other);
+    WireBuffer& operator=(const WireBuffer& other);
+    ~WireBuffer();
+
+    const char* data() const;
+    size_t length() const;
+    bool empty() const;
+
+    // Écriture directe (tampon non encore partagé uniquement)
+    void append(const char* bytes, size_t length);
+};
+
+#endif
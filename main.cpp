@@ -71,7 +71,10 @@ int main(int argc, char* argv[]) {
     
     try {
         // Créer et démarrer le serveur
-        Server server(port, password);
+        ServerConfig config;
+        config.loadFromEnvironment();
+        
+        Server server(port, password, config);
         g_server = &server; // Pour le signal handler
         
         std::cout << BLUE << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << RESET << std::endl;
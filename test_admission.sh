@@ -0,0 +1,69 @@
+#!/bin/bash
+
+# Test du contrôle d'admission : la boucle locale n'est pas limitée par adresse,
+# une autre adresse de la machine l'est (FTIRC_MAX_PER_IP)
+
+PORT=6674
+PASSWORD="testpass"
+FAILED=0
+
+echo "🧪 Test du contrôle d'admission"
+echo "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"
+
+# Adresse non locale de la machine : le serveur y voit un pair hors 127.0.0.0/8
+LAN_IP=$(hostname -I 2>/dev/null | tr ' ' '\n' | grep -v -e '^127\.' -e ':' | head -n 1)
+
+# Démarrer le serveur avec 2 connexions par IP
+FTIRC_MAX_PER_IP=2 ./ft_irc $PORT $PASSWORD > /dev/null &
+SERVER_PID=$!
+sleep 1
+
+check() {
+    if [ "$1" -eq 0 ]; then
+        echo "✅ $2"
+    else
+        echo "❌ $2"
+        FAILED=1
+    fi
+}
+
+# Ouvrir une connexion sur le fd donné et lire ce qu'elle reçoit d'emblée
+refused() {
+    eval "exec $1<>/dev/tcp/$2/$PORT"
+    timeout 0.5 cat <&$1 2>/dev/null | grep -q "ERROR :Closing Link"
+}
+
+# 1. Boucle locale : 5 connexions simultanées, toutes admises
+LOCAL_REFUSED=0
+for fd in 3 4 5 6 7; do
+    refused $fd 127.0.0.1 && LOCAL_REFUSED=$((LOCAL_REFUSED + 1))
+done
+[ $LOCAL_REFUSED -eq 0 ]
+check $? "boucle locale : 5 connexions admises malgré FTIRC_MAX_PER_IP=2"
+exec 3<&- 4<&- 5<&- 6<&- 7<&-
+
+# 2. Adresse non locale : la troisième connexion est refusée
+if [ -z "$LAN_IP" ]; then
+    echo "⚠️  aucune adresse non locale, limite par IP non testée"
+else
+    refused 3 $LAN_IP; FIRST=$?
+    refused 4 $LAN_IP; SECOND=$?
+    exec 5<>/dev/tcp/$LAN_IP/$PORT
+    OUTPUT=$(timeout 2 cat <&5 2>/dev/null)
+    [ $FIRST -ne 0 ] && [ $SECOND -ne 0 ]
+    check $? "$LAN_IP : 2 connexions admises"
+    echo "$OUTPUT" | grep -q "Too many connections from your host"
+    check $? "$LAN_IP : la troisième refusée (Too many connections from your host)"
+    exec 3<&- 4<&- 5<&-
+fi
+
+# Arrêter le serveur
+kill $SERVER_PID 2>/dev/null
+wait $SERVER_PID 2>/dev/null
+
+echo "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"
+if [ $FAILED -ne 0 ]; then
+    echo "❌ Test du contrôle d'admission échoué"
+    exit 1
+fi
+echo "🏁 Test du contrôle d'admission réussi"
@@ -0,0 +1,67 @@
+#!/bin/bash
+
+# Test des noms de canaux invalides : JOIN doit répondre 403/476 sans créer de canal,
+# PRIVMSG vers un canal inexistant 403
+
+PORT=6670
+PASSWORD="testpass"
+SERVER="127.0.0.1"
+FAILED=0
+
+echo "🧪 Test des noms de canaux"
+echo "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"
+
+# Démarrer le serveur en arrière-plan
+./ft_irc $PORT $PASSWORD > /dev/null &
+SERVER_PID=$!
+sleep 1
+
+LONG_NAME="#$(printf 'x%.0s' $(seq 1 100))"
+
+# Session sur /dev/tcp (bash) : QUIT ferme la connexion et termine la lecture
+exec 3<>/dev/tcp/$SERVER/$PORT
+printf "PASS $PASSWORD\r\nNICK tester\r\nUSER tester 0 * :Test User\r\n" >&3
+printf "JOIN foo\r\nJOIN #a,#b\r\nJOIN $LONG_NAME\r\nJOIN #valid\r\n" >&3
+printf "PRIVMSG #nowhere :hello\r\n" >&3
+sleep 1
+printf "QUIT\r\n" >&3
+OUTPUT=$(timeout 5 cat <&3)
+exec 3<&-
+
+check() {
+    if echo "$OUTPUT" | grep -q -- "$1"; then
+        echo "✅ $2"
+    else
+        echo "❌ $2"
+        FAILED=1
+    fi
+}
+
+check_absent() {
+    if echo "$OUTPUT" | grep -q -- "$1"; then
+        echo "❌ $2"
+        FAILED=1
+    else
+        echo "✅ $2"
+    fi
+}
+
+check " 403 tester foo :No such channel" "JOIN sans préfixe de canal : 403"
+check " 476 tester #a,#b :Bad Channel Mask" "JOIN avec une virgule : 476"
+check " 476 tester $LONG_NAME :Bad Channel Mask" "JOIN avec un nom de plus de 50 caractères : 476"
+check_absent "JOIN :foo" "aucun canal créé pour foo"
+check_absent "JOIN :#a,#b" "aucun canal créé pour #a,#b"
+check_absent "JOIN :$LONG_NAME" "aucun canal créé pour le nom trop long"
+check "JOIN :#valid" "JOIN #valid accepté"
+check " 403 tester #nowhere :No such channel" "PRIVMSG vers un canal inexistant : 403"
+
+# Arrêter le serveur
+kill $SERVER_PID 2>/dev/null
+wait $SERVER_PID 2>/dev/null
+
+echo "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"
+if [ $FAILED -ne 0 ]; then
+    echo "❌ Test des noms de canaux échoué"
+    exit 1
+fi
+echo "🏁 Test des noms de canaux réussi"
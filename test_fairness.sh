@@ -0,0 +1,79 @@
+#!/bin/bash
+
+# Test d'équité : un client qui envoie des milliers de lignes d'un coup
+# ne doit pas retarder les commandes d'un autre client (budget par tick)
+
+PORT=6671
+PASSWORD="testpass"
+SERVER="127.0.0.1"
+MAX_LATENCY_MS=200
+FAILED=0
+
+echo "🧪 Test d'équité entre clients"
+echo "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"
+
+# Démarrer le serveur en arrière-plan
+./ft_irc $PORT $PASSWORD > /dev/null &
+SERVER_PID=$!
+sleep 1
+
+# Client qui mesure : enregistré avant la rafale
+exec 4<>/dev/tcp/$SERVER/$PORT
+printf "PASS $PASSWORD\r\nNICK prober\r\nUSER prober 0 * :Prober\r\n" >&4
+while read -t 2 -u 4 REPLY_LINE; do
+    case "$REPLY_LINE" in *" 376 "*|*" 422 "*) break ;; esac
+done
+
+# Client qui inonde
+exec 3<>/dev/tcp/$SERVER/$PORT
+printf "PASS $PASSWORD\r\nNICK flooder\r\nUSER flooder 0 * :Flooder\r\nJOIN #flood\r\n" >&3
+sleep 0.5
+
+# Rafale continue de lignes courtes (le plus de lignes par lecture) :
+# PRIVMSG vers un canal où le client est seul, donc aucune sortie à lire
+yes $'PRIVMSG #flood :x\r' >&3 &
+FLOOD_PID=$!
+sleep 0.5
+
+# Aller-retour PING/PONG du second client pendant la rafale
+WORST=0
+for i in 1 2 3 4 5; do
+    START=$(date +%s%N)
+    printf "PING :probe$i\r\n" >&4
+    GOT=0
+    while read -t 5 -u 4 REPLY_LINE; do
+        case "$REPLY_LINE" in *"PONG"*"probe$i"*) GOT=1; break ;; esac
+    done
+    ELAPSED=$(( ($(date +%s%N) - START) / 1000000 ))
+    [ $GOT -eq 0 ] && ELAPSED=99999
+    [ $ELAPSED -gt $WORST ] && WORST=$ELAPSED
+    sleep 0.1
+done
+
+if kill -0 $FLOOD_PID 2>/dev/null; then
+    echo "✅ client inondant toujours connecté pendant les mesures"
+else
+    echo "❌ client inondant déconnecté avant la fin des mesures"
+    FAILED=1
+fi
+
+if [ $WORST -le $MAX_LATENCY_MS ]; then
+    echo "✅ PONG reçu en ${WORST} ms au pire (limite ${MAX_LATENCY_MS} ms)"
+else
+    echo "❌ PONG reçu en ${WORST} ms au pire (limite ${MAX_LATENCY_MS} ms)"
+    FAILED=1
+fi
+
+# Arrêter les clients et le serveur
+kill $FLOOD_PID 2>/dev/null
+wait $FLOOD_PID 2>/dev/null
+exec 3<&- 4<&-
+kill $SERVER_PID 2>/dev/null
+wait $SERVER_PID 2>/dev/null
+
+echo "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"
+if [ $FAILED -ne 0 ]; then
+    echo "❌ Test d'équité échoué"
+    exit 1
+fi
+echo "🏁 Test d'équité réussi"
@@ -0,0 +1,71 @@
+#!/bin/bash
+
+# Test du contrôle de flood (désactivé par défaut, activé ici par l'environnement) :
+# un client qui dépasse son seau de jetons est ralenti (fakelag), puis déconnecté
+# avec "ERROR :Excess Flood" quand ses lignes en attente dépassent FTIRC_FLOOD_EXCESS
+
+PORT=6672
+PASSWORD="testpass"
+SERVER="127.0.0.1"
+FAILED=0
+
+echo "🧪 Test du contrôle de flood"
+echo "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"
+
+# Démarrer le serveur avec 2 jetons/s, un seau de 10 et 4 Ko d'excès toléré
+FTIRC_FLOOD_RATE=2 FTIRC_FLOOD_BURST=10 FTIRC_FLOOD_EXCESS=4096 \
+    ./ft_irc $PORT $PASSWORD > /dev/null &
+SERVER_PID=$!
+sleep 1
+
+check() {
+    if [ "$1" -eq 0 ]; then
+        echo "✅ $2"
+    else
+        echo "❌ $2"
+        FAILED=1
+    fi
+}
+
+# 1. Fakelag : 30 PING d'un coup, le seau répond tout de suite, le reste à 2 par seconde
+exec 3<>/dev/tcp/$SERVER/$PORT
+printf "PASS $PASSWORD\r\nNICK slow\r\nUSER slow 0 * :Slow\r\n" >&3
+sleep 0.5
+for i in $(seq 1 30); do printf "PING :p$i\r\n"; done >&3
+sleep 0.5
+PONGS=$(timeout 1 cat <&3 | grep -c "PONG")
+exec 3<&-
+[ "$PONGS" -gt 0 ] && [ "$PONGS" -lt 30 ]
+check $? "fakelag : $PONGS PONG sur 30 dans la première seconde et demie"
+
+# 2. Excess Flood : 200 PRIVMSG de 100 octets (~20 Ko) bien au-delà des 4 Ko tolérés
+exec 3<>/dev/tcp/$SERVER/$PORT
+printf "PASS $PASSWORD\r\nNICK flooder\r\nUSER flooder 0 * :Flooder\r\n" >&3
+sleep 0.5
+BODY=$(printf 'x%.0s' $(seq 1 80))
+for i in $(seq 1 200); do printf "PRIVMSG flooder :$BODY\r\n"; done >&3 2>/dev/null
+OUTPUT=$(timeout 5 cat <&3)
+exec 3<&-
+echo "$OUTPUT" | grep -q "ERROR :Excess Flood"
+check $? "rafale de 20 Ko : ERROR :Excess Flood et déconnexion"
+
+# 3. Un autre client n'est pas affecté
+exec 3<>/dev/tcp/$SERVER/$PORT
+printf "PASS $PASSWORD\r\nNICK polite\r\nUSER polite 0 * :Polite\r\nPING :hello\r\n" >&3
+sleep 0.5
+printf "QUIT\r\n" >&3
+OUTPUT=$(timeout 5 cat <&3)
+exec 3<&-
+echo "$OUTPUT" | grep -q "PONG.*hello"
+check $? "client sage servi normalement"
+
+# Arrêter le serveur
+kill $SERVER_PID 2>/dev/null
+wait $SERVER_PID 2>/dev/null
+
+echo "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"
+if [ $FAILED -ne 0 ]; then
+    echo "❌ Test du contrôle de flood échoué"
+    exit 1
+fi
+echo "🏁 Test du contrôle de flood réussi"
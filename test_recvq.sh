@@ -0,0 +1,66 @@
+#!/bin/bash
+
+# Test des limites d'entrée : une ligne de plus de 512 octets reçoit 417 sans être
+# exécutée, et un client dont les octets non traités dépassent FTIRC_RECVQ_MAX
+# est déconnecté avec "ERROR :RecvQ exceeded"
+
+PORT=6673
+PASSWORD="testpass"
+SERVER="127.0.0.1"
+FAILED=0
+
+echo "🧪 Test des limites d'entrée"
+echo "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"
+
+# Démarrer le serveur avec une RecvQ de 4 Ko (64 Ko par défaut)
+FTIRC_RECVQ_MAX=4096 ./ft_irc $PORT $PASSWORD > /dev/null &
+SERVER_PID=$!
+sleep 1
+
+check() {
+    if [ "$1" -eq 0 ]; then
+        echo "✅ $2"
+    else
+        echo "❌ $2"
+        FAILED=1
+    fi
+}
+
+# 1. Ligne trop longue : 417, la connexion reste utilisable
+LONG_TEXT=$(printf 'x%.0s' $(seq 1 600))
+exec 3<>/dev/tcp/$SERVER/$PORT
+printf "PASS $PASSWORD\r\nNICK longline\r\nUSER longline 0 * :Long Line\r\n" >&3
+printf "PRIVMSG longline :$LONG_TEXT\r\nPING :still-here\r\n" >&3
+sleep 0.5
+printf "QUIT\r\n" >&3
+OUTPUT=$(timeout 5 cat <&3)
+exec 3<&-
+echo "$OUTPUT" | grep -q " 417 longline :Input line was too long"
+check $? "ligne de 600 octets : 417"
+! echo "$OUTPUT" | grep -q "PRIVMSG longline :x"
+check $? "ligne trop longue non exécutée"
+echo "$OUTPUT" | grep -q "PONG.*still-here"
+check $? "connexion toujours servie après 417"
+
+# 2. Rafale de 20 Ko en une écriture : au-delà des 4 Ko de RecvQ
+BODY=$(printf 'y%.0s' $(seq 1 80))
+BURST=$(for i in $(seq 1 200); do printf "PRIVMSG burster :$BODY\r\n"; done)
+exec 3<>/dev/tcp/$SERVER/$PORT
+printf "PASS $PASSWORD\r\nNICK burster\r\nUSER burster 0 * :Burster\r\n" >&3
+sleep 0.5
+printf "%s" "$BURST" >&3 2>/dev/null
+OUTPUT=$(timeout 5 cat <&3 2>/dev/null)
+exec 3<&-
+echo "$OUTPUT" | grep -q "ERROR :RecvQ exceeded"
+check $? "rafale de 20 Ko : ERROR :RecvQ exceeded et déconnexion"
+
+# Arrêter le serveur
+kill $SERVER_PID 2>/dev/null
+wait $SERVER_PID 2>/dev/null
+
+echo "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"
+if [ $FAILED -ne 0 ]; then
+    echo "❌ Test des limites d'entrée échoué"
+    exit 1
+fi
+echo "🏁 Test des limites d'entrée réussi"
@@ -0,0 +1,248 @@
+// Vérification du parser IRCMessage (make check)
+// 1. Équivalence avec l'ancien parser istringstream sur un corpus de trafic client
+// 2. Cas limites : 15 paramètres et plus, final, préfixe, commande démesurée, ligne tronquée
+// 3. Micro-benchmark : débit des deux parsers sur le même corpus
+
+#include "IRCMessage.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <ctime>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Ancien parser (CommandParser::IRCMessage + splitParams), recopié à l'identique
+struct LegacyMessage {
+    std::string prefix;
+    std::string command;
+    std::vector<std::string> params;
+
+    static std::vector<std::string> splitParams(const std::string& params) {
+        std::vector<std::string> result;
+        std::istringstream iss(params);
+        std::string token;
+
+        while (iss >> token) {
+            if (token[0] == ':') {
+                std::string trailing = token.substr(1);
+                std::string remaining;
+                std::getline(iss, remaining);
+                if (!remaining.empty())
+                    trailing += remaining;
+                result.push_back(trailing);
+                break;
+            } else {
+                result.push_back(token);
+            }
+        }
+        return result;
+    }
+
+    LegacyMessage(const std::string& raw) {
+        std::istringstream iss(raw);
+
+        if (raw[0] == ':') {
+            iss >> prefix;
+            prefix = prefix.substr(1);
+        }
+        if (iss >> command)
+            std::transform(command.begin(), command.end(), command.begin(), ::toupper);
+
+        std::string remaining;
+        std::getline(iss, remaining);
+        if (!remaining.empty() && remaining[0] == ' ')
+            remaining = remaining.substr(1);
+        if (!remaining.empty())
+            params = splitParams(remaining);
+    }
+};
+
+// Trafic de clients réels (irssi, WeeChat, HexChat, bots), sans terminateur
+static const char* CORPUS[] = {
+    "CAP LS 302",
+    "PASS password",
+    "NICK alice",
+    "USER alice 0 * :Alice Liddell",
+    "USER weechat 8 * :WeeChat 4.1.2",
+    "CAP END",
+    "PING :ft_irc.42.fr",
+    "PING 1697461234",
+    "PONG :ft_irc.42.fr",
+    "JOIN #general",
+    "JOIN #general,#random key1,key2",
+    "JOIN &local",
+    "join #lower",
+    "PART #general :Leaving",
+    "PART #random",
+    "PRIVMSG #general :Hello everyone!",
+    "PRIVMSG #general :\x01" "ACTION waves\x01",
+    "PRIVMSG bob :hey, are you there?",
+    "PRIVMSG #general :spaces  inside   the   text ",
+    "PRIVMSG #general ::-) starts with a colon",
+    "PRIVMSG #general :",
+    "privmsg #general :lowercase command",
+    "NOTICE bob :\x01VERSION HexChat 2.16.1\x01",
+    "MODE #general",
+    "MODE #general +itk secret",
+    "MODE #general +l 25",
+    "MODE #general -o+v bob carol",
+    "MODE alice +i",
+    "TOPIC #general",
+    "TOPIC #general :Welcome to #general | rules: be nice",
+    "TOPIC #general :",
+    "KICK #general bob :Spamming",
+    "KICK #general bob",
+    "INVITE carol #general",
+    "WHO #general",
+    "WHOIS bob",
+    "OPER admin secret",
+    "STATS q",
+    "QUIT",
+    "QUIT :Gone to lunch",
+    "NICK   spaced",
+    "  PING :leading spaces",
+    "NICK bob   ",
+    ":alice!alice@127.0.0.1 PRIVMSG #general :relayed line",
+    ":ft_irc.42.fr 001 alice :Welcome to the Internet Relay Network alice",
+    ":alice NICK :alicia",
+    "MODE #k +k a:b",
+    "USER guest 0 * :",
+    "PRIVMSG #a,#b,carol :multi target",
+    "A B C D E F G H I J K L M N O",
+    "CMD 1 2 3 4 5 6 7 8 9 10 11 12 13 14",
+    "CMD 1 2 3 4 5 6 7 8 9 10 11 12 13 :fourteenth trailing",
+};
+static const size_t CORPUS_SIZE = sizeof(CORPUS) / sizeof(CORPUS[0]);
+
+static int failures = 0;
+static volatile size_t sink;     // Empêche l'optimiseur de supprimer les boucles
+
+static void fail(const std::string& line, const std::string& what) {
+    std::printf("FAIL [%s]: %s\n", line.c_str(), what.c_str());
+    ++failures;
+}
+
+static void checkEquivalent(const std::string& line) {
+    LegacyMessage legacy(line);
+    IRCMessage message;
+    bool parsed = message.parse(StringView(line));
+
+    if (!parsed) {
+        if (!legacy.command.empty())
+            fail(line, "aucune commande");
+        return;
+    }
+    if (message.prefix.str() != legacy.prefix)
+        fail(line, "préfixe " + message.prefix.str() + " / " + legacy.prefix);
+    if (message.command.str() != legacy.command)
+        fail(line, "commande " + message.command.str() + " / " + legacy.command);
+    if (message.params.size() != legacy.params.size()) {
+        fail(line, "nombre de paramètres");
+        return;
+    }
+    for (size_t i = 0; i < message.params.size(); ++i) {
+        if (message.params[i].str() != legacy.params[i])
+            fail(line, "paramètre " + message.params[i].str() + " / " + legacy.params[i]);
+    }
+}
+
+static void expect(bool condition, const std::string& line, const std::string& what) {
+    if (!condition)
+        fail(line, what);
+}
+
+static void checkEdgeCases() {
+    IRCMessage message;
+
+    // Au-delà de 15 paramètres, le 15e prend le reste de la ligne (RFC 1459)
+    std::string many = "CMD 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17";
+    message.parse(StringView(many));
+    expect(message.params.size() == 15, many, "15 paramètres au plus");
+    expect(message.params[14].str() == "15 16 17", many, "15e paramètre = reste de la ligne");
+
+    // Le paramètre final garde ses espaces et ses ':'
+    std::string trailing = "PRIVMSG #a :one :two  three";
+    message.parse(StringView(trailing));
+    expect(message.params.size() == 2 && message.params[1].str() == "one :two  three",
+           trailing, "paramètre final");
+
+    // Préfixe seul : pas de commande
+    std::string prefixOnly = ":nick!user@host";
+    expect(!message.parse(StringView(prefixOnly)), prefixOnly, "préfixe sans commande");
+
+    // Commande démesurée : jeton source entier, jamais tronqué ni reconnu (421)
+    std::string longCommand = "privmsg" + std::string(40, 'x') + " bob :hi";
+    message.parse(StringView(longCommand));
+    expect(message.command.str() == "privmsg" + std::string(40, 'x'), longCommand,
+           "commande démesurée rendue entière");
+
+    std::string limitCommand = std::string(IRCMessage::MAX_COMMAND_LENGTH, 'a');
+    message.parse(StringView(limitCommand));
+    expect(message.command.str() == std::string(IRCMessage::MAX_COMMAND_LENGTH, 'A'), limitCommand,
+           "commande de longueur maximale en majuscules");
+
+    // Ligne au-delà de 512 octets (CRLF compris) : coupée et signalée (417)
+    std::string longLine = "PRIVMSG #a :" + std::string(600, 'A');
+    message.parse(StringView(longLine));
+    expect(message.truncated, "PRIVMSG #a :A…", "ligne longue signalée tronquée");
+    expect(message.params.size() == 2 && message.params[1].length == IRCMessage::MAX_LENGTH - 2 - 12,
+           "PRIVMSG #a :A…", "ligne coupée à 510 octets");
+
+    std::string exactLine = "PRIVMSG #a :" + std::string(IRCMessage::MAX_LENGTH - 2 - 12, 'A');
+    message.parse(StringView(exactLine));
+    expect(!message.truncated, "PRIVMSG #a :A… (510)", "ligne de 510 octets acceptée");
+}
+
+static double seconds() {
+    return (double)std::clock() / CLOCKS_PER_SEC;
+}
+
+// Débit des deux parsers ; retourne le rapport nouveau / ancien
+static double benchmark() {
+    static const size_t ROUNDS = 20000;
+    std::vector<std::string> lines(CORPUS, CORPUS + CORPUS_SIZE);
+
+    double start = seconds();
+    for (size_t round = 0; round < ROUNDS; ++round) {
+        for (size_t i = 0; i < lines.size(); ++i) {
+            LegacyMessage legacy(lines[i]);
+            sink += legacy.params.size();
+        }
+    }
+    double legacyTime = seconds() - start;
+
+    IRCMessage message;
+    start = seconds();
+    for (size_t round = 0; round < ROUNDS; ++round) {
+        for (size_t i = 0; i < lines.size(); ++i) {
+            message.parse(StringView(lines[i]));
+            sink += message.params.size();
+        }
+    }
+    double parserTime = seconds() - start;
+
+    double total = (double)ROUNDS * lines.size();
+    std::printf("istringstream : %8.0f lignes/ms\n", total / (legacyTime * 1000));
+    std::printf("IRCMessage    : %8.0f lignes/ms\n", total / (parserTime * 1000));
+    return parserTime > 0 ? legacyTime / parserTime : 0;
+}
+
+int main() {
+    for (size_t i = 0; i < CORPUS_SIZE; ++i)
+        checkEquivalent(CORPUS[i]);
+    checkEdgeCases();
+    if (failures) {
+        std::printf("parser_check: %d échec(s)\n", failures);
+        return 1;
+    }
+    std::printf("parser_check: %lu lignes identiques, cas limites OK\n", (unsigned long)CORPUS_SIZE);
+
+    double speedup = benchmark();
+    std::printf("accélération : x%.1f\n", speedup);
+    if (speedup < 10) {
+        std::printf("parser_check: accélération inférieure à x10\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Vérification du préfixe client en cache (make check)
+// Compte les allocations (operator new global) sur le chemin de diffusion :
+// getPrefix() ne doit rien allouer, l'ancienne concaténation allouait à chaque appel
+
+#include "Client.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+static size_t allocations = 0;
+
+void* operator new(size_t size) throw(std::bad_alloc) {
+    ++allocations;
+    void* p = std::malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) throw() {
+    std::free(p);
+}
+
+static const size_t ROUNDS = 1000000;
+static volatile size_t sink;     // Empêche l'optimiseur de supprimer les boucles
+static int failures = 0;
+
+static void expect(bool condition, const char* what) {
+    if (!condition) {
+        std::printf("FAIL: %s\n", what);
+        ++failures;
+    }
+}
+
+int main() {
+    Client client(-1, NULL);
+    client.setNickname("alice");
+    client.setUsername("alice");
+    client.setHostname("127.0.0.1");
+    expect(client.getPrefix() == ":alice!alice@127.0.0.1", "préfixe initial");
+
+    // Ancienne construction : ":" + nick + "!" + user + "@" + host à chaque appel
+    size_t before = allocations;
+    for (size_t i = 0; i < ROUNDS; ++i) {
+        std::string prefix = ":" + client.getNickname() + "!" + client.getUsername()
+                           + "@" + client.getHostname();
+        sink += prefix.length();
+    }
+    size_t legacy = allocations - before;
+
+    before = allocations;
+    for (size_t i = 0; i < ROUNDS; ++i)
+        sink += client.getPrefix().length();
+    size_t cached = allocations - before;
+
+    std::printf("concaténation : %lu allocations / %lu appels\n", (unsigned long)legacy, (unsigned long)ROUNDS);
+    std::printf("getPrefix()   : %lu allocations / %lu appels\n", (unsigned long)cached, (unsigned long)ROUNDS);
+    expect(cached == 0, "getPrefix() alloue");
+
+    // Même valeur : pas de reconstruction
+    before = allocations;
+    client.setNickname("alice");
+    client.setUsername("alice");
+    client.setHostname("127.0.0.1");
+    expect(allocations == before, "setter sans changement alloue");
+
+    // Changement d'identité : préfixe reconstruit
+    client.setNickname("alicia");
+    expect(client.getPrefix() == ":alicia!alice@127.0.0.1", "préfixe après NICK");
+
+    if (failures) {
+        std::printf("prefix_check: %d échec(s)\n", failures);
+        return 1;
+    }
+    std::printf("prefix_check: OK\n");
+    return 0;
+}